@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 3:40:52am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Shared/GoldenRender.h"
+#include "../../Shared/SimdKernels.h"
+#include "../../SimpleDistortion/Source/Data/Waveshaper.h"
+
+// Each plugin's createPluginFilter, renamed by its file in Processors.
+juce::AudioProcessor* JUCE_CALLTYPE createSimpleChain();
+juce::AudioProcessor* JUCE_CALLTYPE createSimpleDistortion();
+juce::AudioProcessor* JUCE_CALLTYPE createSimpleFilter();
+juce::AudioProcessor* JUCE_CALLTYPE createSimpleReverb();
+juce::AudioProcessor* JUCE_CALLTYPE createSimpleStereoFlipper();
+juce::AudioProcessor* JUCE_CALLTYPE createSimpleStereoGainAdjust();
+
+// In ReBlockerCheck.cpp.
+juce::String checkReBlocker(bool& allMatched);
+
+// The References folder is next to the .jucer, so it looks for it above wherever the build put the executable.
+static juce::File findReferenceFolder()
+{
+    for (auto folder = juce::File::getSpecialLocation(juce::File::currentExecutableFile).getParentDirectory();
+         ! folder.isRoot(); folder = folder.getParentDirectory())
+    {
+        if (folder.getChildFile("References").isDirectory())
+            return folder.getChildFile("References");
+    }
+
+    return juce::File::getCurrentWorkingDirectory().getChildFile("References");
+}
+
+//==============================================================================
+// Renders every plugin's processor at its default settings and checks it against the committed references.
+// It returns 1 if anything came out different, so it can fail a build.
+//
+//   RenderCheck [--update] [--benchmark] [--references <folder>]
+//
+// --update stores new references instead, for when the sound is meant to have changed.
+// --benchmark times the shared kernels and the waveshaper curves as well.
+int main(int argc, char* argv[])
+{
+    // The parameter trees flush on a timer, which needs a message manager even with nothing on screen.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList arguments(argc, argv);
+    const auto updateReferences = arguments.containsOption("--update");
+    const auto benchmark = arguments.containsOption("--benchmark");
+    const auto referenceFolder = arguments.containsOption("--references")
+                               ? juce::File::getCurrentWorkingDirectory().getChildFile(arguments.getValueForOption("--references"))
+                               : findReferenceFolder();
+
+    // The timings depend on which kernels this machine picked, so the report says which.
+    std::cout << "Kernels: " << SimdKernels::getName(SimdKernels::get().isa) << std::endl;
+    std::cout << "References: " << referenceFolder.getFullPathName() << std::endl;
+
+    auto allMatched = true;
+    std::cout << checkReBlocker(allMatched);
+
+    for (auto create : { createSimpleChain, createSimpleDistortion, createSimpleFilter,
+                         createSimpleReverb, createSimpleStereoFlipper, createSimpleStereoGainAdjust })
+    {
+        std::unique_ptr<juce::AudioProcessor> processor(create());
+
+        std::cout << GoldenRender::run(*processor, referenceFolder, GoldenRender::Tolerance::bitExact(), {},
+                                       updateReferences, &allMatched);
+    }
+
+    if (benchmark)
+    {
+        std::cout << SimdKernels::runBenchmark();
+        std::cout << Waveshaper::runBenchmark();
+    }
+
+    if (! allMatched)
+        std::cout << "Some renders didn't match their references, the output is next to them as .failed.wav" << std::endl;
+
+    return allMatched ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+/*
+  ==============================================================================
+
+    SimpleDistortionProcessor.cpp
+    Created: 19 Oct 2026 3:42:12am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+// The plugin's own processor, compiled here without the plugin wrapper. The wrapper is what normally defines
+// the name, and every plugin's factory is called createPluginFilter, so this one gets a name of its own.
+#define JucePlugin_Name "SimpleDistortion"
+#define createPluginFilter createSimpleDistortion
+
+#include "../../../SimpleDistortion/Source/PluginProcessor.cpp"
@@ -0,0 +1,16 @@
+/*
+  ==============================================================================
+
+    SimpleFilterProcessor.cpp
+    Created: 19 Oct 2026 3:43:13am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+// The plugin's own processor, compiled here without the plugin wrapper. The wrapper is what normally defines
+// the name, and every plugin's factory is called createPluginFilter, so this one gets a name of its own.
+#define JucePlugin_Name "SimpleFilter"
+#define createPluginFilter createSimpleFilter
+
+#include "../../../SimpleFilter/Source/PluginProcessor.cpp"
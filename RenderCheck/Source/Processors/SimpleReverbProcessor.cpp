@@ -0,0 +1,16 @@
+/*
+  ==============================================================================
+
+    SimpleReverbProcessor.cpp
+    Created: 19 Oct 2026 3:44:14am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+// The plugin's own processor, compiled here without the plugin wrapper. The wrapper is what normally defines
+// the name, and every plugin's factory is called createPluginFilter, so this one gets a name of its own.
+#define JucePlugin_Name "SimpleReverb"
+#define createPluginFilter createSimpleReverb
+
+#include "../../../SimpleReverb/Source/PluginProcessor.cpp"
@@ -0,0 +1,16 @@
+/*
+  ==============================================================================
+
+    SimpleStereoGainAdjustProcessor.cpp
+    Created: 19 Oct 2026 3:46:16am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+// The plugin's own processor, compiled here without the plugin wrapper. The wrapper is what normally defines
+// the name, and every plugin's factory is called createPluginFilter, so this one gets a name of its own.
+#define JucePlugin_Name "SimpleStereoGainAdjust"
+#define createPluginFilter createSimpleStereoGainAdjust
+
+#include "../../../SimpleStereoGainAdjust/Source/PluginProcessor.cpp"
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    ReBlockerCheck.cpp
+    Created: 19 Oct 2026 4:21:37am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Shared/ReBlocker.h"
+
+// Feeds a ramp through both modes in fragments of every size from 1 to 17 samples, so the FIFO has to fill
+// across fragment boundaries in every possible way. Fixed latency has to hand the kernel only whole, aligned
+// blocks and give the ramp back exactly its latency late. Passthrough has to give it back untouched, in
+// pieces no bigger than the block size.
+juce::String checkReBlocker(bool& allMatched)
+{
+    constexpr int blockSize{ 64 };
+    constexpr int numChannels{ 2 };
+    constexpr int length{ 4096 };
+
+    juce::String report;
+
+    for (auto mode : { ReBlocker::Mode::fixedLatency, ReBlocker::Mode::passthrough })
+    {
+        const auto isFixed = mode == ReBlocker::Mode::fixedLatency;
+
+        ReBlocker reBlocker;
+        reBlocker.prepareToPlay(blockSize, numChannels, mode);
+
+        // Each channel gets its own ramp so a mixed up channel shows.
+        juce::AudioBuffer<float> buffer(numChannels, length);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < length; ++i)
+                buffer.setSample(channel, i, (float)(i + 1 + channel * length));
+
+        juce::String error;
+        auto fragmentSize = 1;
+
+        for (int start = 0; start < length; start += fragmentSize, fragmentSize = fragmentSize % 17 + 1)
+        {
+            auto fragment = juce::dsp::AudioBlock<float>(buffer).getSubBlock((size_t)start, (size_t)juce::jmin(fragmentSize, length - start));
+
+            reBlocker.process(fragment, [&](juce::dsp::AudioBlock<float>& block)
+            {
+                const auto isWhole = (int)block.getNumSamples() == blockSize;
+                const auto isAligned = juce::snapPointerToAlignment(block.getChannelPointer(0), DspArena::alignment) == block.getChannelPointer(0);
+
+                if (isFixed && (! isWhole || ! isAligned) && error.isEmpty())
+                    error = "the kernel got " + juce::String(block.getNumSamples()) + " samples" + (isAligned ? "" : ", not aligned");
+
+                if (! isFixed && (int)block.getNumSamples() > blockSize && error.isEmpty())
+                    error = "the kernel got " + juce::String(block.getNumSamples()) + " samples";
+            });
+        }
+
+        const auto latency = reBlocker.getLatencySamples();
+
+        if (latency != (isFixed ? blockSize : 0) && error.isEmpty())
+            error = "it reported " + juce::String(latency) + " samples of latency";
+
+        for (int channel = 0; channel < numChannels && error.isEmpty(); ++channel)
+        {
+            for (int i = 0; i < length; ++i)
+            {
+                const auto expected = i < latency ? 0.0f : (float)(i - latency + 1 + channel * length);
+
+                if (buffer.getSample(channel, i) != expected)
+                {
+                    error = "sample " + juce::String(i) + " of channel " + juce::String(channel) + " is "
+                          + juce::String(buffer.getSample(channel, i)) + ", not " + juce::String(expected);
+                    break;
+                }
+            }
+        }
+
+        report << ("ReBlocker " + juce::String(isFixed ? "fixed latency" : "passthrough")).paddedRight(' ', 32)
+               << (error.isEmpty() ? "matched" : "DIFFERENT, " + error) << juce::newLine;
+
+        if (error.isNotEmpty())
+            allMatched = false;
+    }
+
+    return report;
+}
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    DspArena.cpp
+    Created: 18 Oct 2026 10:12:48pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "DspArena.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#else
+ #include <sys/mman.h>
+#endif
+
+namespace
+{
+    constexpr size_t hugePageSize{ 2 * 1024 * 1024 };
+}
+
+DspArena::~DspArena()
+{
+    release();
+}
+
+void DspArena::prepare(size_t requiredBytes)
+{
+    usedBytes = 0;
+
+    // The same spec as last time needs the same amount, so the slab that's already there gets reused.
+    if (slab != nullptr && requiredBytes <= capacity && askedForHugePages == useHugePages)
+    {
+        std::memset(slab, 0, capacity);
+        return;
+    }
+
+    release();
+
+    if (requiredBytes == 0)
+        return;
+
+    // The pages come straight from the system, so the slab starts page aligned and already zeroed.
+    auto bytes = useHugePages ? (requiredBytes + hugePageSize - 1) & ~(hugePageSize - 1) : requiredBytes;
+    void* memory = nullptr;
+    askedForHugePages = useHugePages;
+
+   #if JUCE_WINDOWS
+    // Large pages need the lock pages in memory privilege, which most users won't have, so this often falls through.
+    if (useHugePages)
+    {
+        const auto largePageSize = GetLargePageMinimum();
+
+        if (largePageSize > 0)
+        {
+            const auto largeBytes = (requiredBytes + largePageSize - 1) & ~(largePageSize - 1);
+            memory = VirtualAlloc(nullptr, largeBytes, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+
+            if (memory != nullptr)
+                bytes = largeBytes;
+        }
+    }
+
+    hasHugePages = memory != nullptr;
+
+    if (memory == nullptr)
+        memory = VirtualAlloc(nullptr, bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+   #else
+   #if defined(MAP_HUGETLB)
+    // Explicit huge pages only exist if the system has some set aside.
+    if (useHugePages)
+    {
+        memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (memory == MAP_FAILED)
+            memory = nullptr;
+    }
+   #endif
+
+    hasHugePages = memory != nullptr;
+
+    if (memory == nullptr)
+    {
+        memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (memory == MAP_FAILED)
+            memory = nullptr;
+
+       #if defined(MADV_HUGEPAGE)
+        // Otherwise ask for transparent huge pages, which the kernel is free to ignore.
+        if (memory != nullptr && useHugePages)
+            hasHugePages = madvise(memory, bytes, MADV_HUGEPAGE) == 0;
+       #endif
+    }
+   #endif
+
+    jassert(memory != nullptr);
+
+    slab = static_cast<char*>(memory);
+    capacity = memory != nullptr ? bytes : 0;
+}
+
+void DspArena::allocateBuffer(juce::AudioBuffer<float>& buffer, int numChannels, int numSamples)
+{
+    std::vector<float*> channels((size_t)numChannels);
+
+    for (auto& channel : channels)
+    {
+        channel = allocate<float>((size_t)numSamples);
+
+        // A fresh buffer rather than setSize(), which would keep pointing at the old memory if the size matched.
+        if (channel == nullptr)
+        {
+            buffer = juce::AudioBuffer<float>(numChannels, numSamples);
+            buffer.clear();
+            return;
+        }
+    }
+
+    buffer.setDataToReferTo(channels.data(), numChannels, numSamples);
+}
+
+void DspArena::release()
+{
+    if (slab == nullptr)
+        return;
+
+   #if JUCE_WINDOWS
+    VirtualFree(slab, 0, MEM_RELEASE);
+   #else
+    munmap(slab, capacity);
+   #endif
+
+    slab = nullptr;
+    capacity = 0;
+    usedBytes = 0;
+    hasHugePages = false;
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    DspArena.h
+    Created: 18 Oct 2026 10:12:48pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// One contiguous slab of memory a processor hands out all of its DSP buffers from, instead of each of them
+// being allocated somewhere different. Every piece starts on a 64 byte cache line.
+//
+// The processor adds up what everything needs with their getRequiredBytes(), calls prepare() with the total,
+// and then prepares each of them with the arena so they take their share. Preparing again with the same or a
+// smaller total keeps the slab it already has and only clears it.
+class DspArena
+{
+public:
+    DspArena() = default;
+    ~DspArena();
+
+    static constexpr size_t alignment{ 64 };
+
+    // What a request of this many bytes takes up once it is padded out to the next cache line.
+    static size_t getAlignedSize(size_t bytes) { return (bytes + alignment - 1) & ~(alignment - 1); }
+
+    // What allocateBuffer() takes, every channel starts on its own cache line.
+    static size_t getBufferSize(int numChannels, int numSamples) { return (size_t)numChannels * getAlignedSize((size_t)numSamples * sizeof(float)); }
+
+    // Backs the slab with huge pages where the system has them, which saves on TLB misses once a few
+    // instances are running. It falls back to normal pages if none are free. Takes effect on the next prepare().
+    void setUseHugePages(const bool shouldUseHugePages) { useHugePages = shouldUseHugePages; }
+
+    // Makes sure there is at least this much and goes back to the start of it, zeroed.
+    void prepare(size_t requiredBytes);
+
+    // The next piece of the slab, big enough for count of T. The total handed to prepare() has to cover it,
+    // and if it doesn't, or the system wouldn't give the slab any memory at all, this returns nullptr.
+    template <typename T>
+    T* allocate(size_t count)
+    {
+        const auto bytes = getAlignedSize(count * sizeof(T));
+
+        // A processor that added up its sizes wrong should still hear about it while debugging.
+        jassert(slab == nullptr || usedBytes + bytes <= capacity);
+
+        if (slab == nullptr || usedBytes + bytes > capacity)
+            return nullptr;
+
+        auto* start = slab + usedBytes;
+        usedBytes += bytes;
+        return reinterpret_cast<T*>(start);
+    }
+
+    // The same, but when the slab can't cover it the piece comes off the heap instead, zeroed and still
+    // lined up on a cache line. The caller keeps fallback for as long as it uses the piece.
+    template <typename T>
+    T* allocate(size_t count, juce::HeapBlock<char>& fallback)
+    {
+        if (auto* piece = allocate<T>(count))
+        {
+            fallback.free();
+            return piece;
+        }
+
+        fallback.calloc(getAlignedSize(count * sizeof(T)) + alignment);
+        return reinterpret_cast<T*>(juce::snapPointerToAlignment(fallback.get(), alignment));
+    }
+
+    // Points the buffer at a piece of the slab for each channel, the buffer doesn't own any of it.
+    // If the slab can't cover every channel the buffer gets its own memory on the heap instead, cleared.
+    void allocateBuffer(juce::AudioBuffer<float>& buffer, int numChannels, int numSamples);
+
+    size_t getCapacity() const { return capacity; }
+    size_t getUsedBytes() const { return usedBytes; }
+    bool isUsingHugePages() const { return hasHugePages; }
+
+private:
+    void release();
+
+    char* slab{ nullptr };
+    size_t capacity{ 0 };
+    size_t usedBytes{ 0 };
+
+    bool useHugePages{ false };
+    bool hasHugePages{ false };
+    bool askedForHugePages{ false };
+
+    JUCE_DECLARE_NON_COPYABLE(DspArena)
+};
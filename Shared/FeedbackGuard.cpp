@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    FeedbackGuard.cpp
+    Created: 18 Oct 2026 9:40:03pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "FeedbackGuard.h"
+
+void FeedbackGuard::setProtection(const Protection newProtection)
+{
+    // next() always adds both, so the protection only has to pick which one is zero.
+    dcOffset = newProtection == Protection::dcOffset ? antiDenormal : 0.0f;
+    noiseScale = newProtection == Protection::noise ? antiDenormal / 2147483648.0f : 0.0f;
+}
+
+void FeedbackGuard::protect(juce::dsp::AudioBlock<float>& block)
+{
+    const auto numSamples = (int)block.getNumSamples();
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* data = block.getChannelPointer(channel);
+
+        if (noiseScale == 0.0f)
+        {
+            if (dcOffset != 0.0f)
+                juce::FloatVectorOperations::add(data, dcOffset, numSamples);
+        }
+        else
+        {
+            for (int sample = 0; sample < numSamples; ++sample)
+                data[sample] += next();
+        }
+    }
+}
+
+bool FeedbackGuard::isHealthy(const juce::dsp::AudioBlock<float>& block)
+{
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+        if (! isHealthy(block.getChannelPointer(channel), (int)block.getNumSamples()))
+            return false;
+
+    return true;
+}
+
+bool FeedbackGuard::isHealthy(const float* data, int numSamples)
+{
+    using Lanes = juce::dsp::SIMDRegister<float>;
+
+    // x - x is zero for every finite sample and NaN for a NaN or an infinity, and a NaN stays NaN
+    // once it is in the sum, so a single add per sample finds both.
+    auto check = 0.0f;
+    auto peak = 0.0f;
+
+    // The registers can only load from aligned memory, so the samples before the first aligned one go on their own.
+    const auto* aligned = juce::snapPointerToAlignment(data, (size_t)Lanes::SIMDRegisterSize);
+    const auto head = juce::jmin(numSamples, (int)(aligned - data));
+
+    for (int sample = 0; sample < head; ++sample)
+    {
+        check += data[sample] - data[sample];
+        peak = juce::jmax(peak, std::abs(data[sample]));
+    }
+
+    const auto numRegisters = (numSamples - head) / (int)Lanes::size();
+    auto checkLanes = Lanes::expand(0.0f);
+    auto peakLanes = Lanes::expand(0.0f);
+
+    for (int i = 0; i < numRegisters; ++i)
+    {
+        const auto signal = Lanes::fromRawArray(aligned + i * (int)Lanes::size());
+        checkLanes += signal - signal;
+        peakLanes = Lanes::max(peakLanes, Lanes::abs(signal));
+    }
+
+    check += checkLanes.sum();
+
+    for (size_t lane = 0; lane < Lanes::size(); ++lane)
+        peak = juce::jmax(peak, peakLanes.get(lane));
+
+    for (int sample = head + numRegisters * (int)Lanes::size(); sample < numSamples; ++sample)
+    {
+        check += data[sample] - data[sample];
+        peak = juce::jmax(peak, std::abs(data[sample]));
+    }
+
+    // Written so a NaN in either of them fails.
+    return check == 0.0f && peak <= blowUpLimit;
+}
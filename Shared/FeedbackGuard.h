@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    FeedbackGuard.h
+    Created: 18 Oct 2026 9:40:03pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Keeps anything with a feedback path out of the two ways it can go wrong. Tails that die away end up in
+// denormals, which are very slow on some CPUs, and ScopedNoDenormals only helps where the CPU has a flag
+// for it. So a tiny offset, far below anything audible, is added ahead of the feedback to keep it out of
+// that range on every platform. The other is a NaN or infinity getting in, which would go round the loop
+// forever, so the output gets checked every block and the owner clears its state when it isn't healthy.
+class FeedbackGuard
+{
+public:
+    // What gets added to keep the loop out of denormals. The DC offset is cheapest, the noise is for anything
+    // that blocks DC, like a high pass, where the offset would just end up being filtered out.
+    enum class Protection { none, dcOffset, noise };
+
+    void setProtection(const Protection newProtection);
+
+    // Adds the offset or noise to every sample of the block.
+    void protect(juce::dsp::AudioBlock<float>& block);
+
+    // The same for loops that already go sample by sample. It doesn't branch on the protection.
+    float next() noexcept
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return dcOffset + noiseScale * (float)(juce::int32)seed;
+    }
+
+    // True when every sample is finite and below blowUpLimit. Goes through four or eight samples at a time.
+    static bool isHealthy(const juce::dsp::AudioBlock<float>& block);
+    static bool isHealthy(const float* data, int numSamples);
+
+    // About +80dB, past anything the processors here can make without having blown up.
+    static constexpr float blowUpLimit{ 1.0e4f };
+
+    // About -400dB, still many orders of magnitude above the largest denormal.
+    static constexpr float antiDenormal{ 1.0e-20f };
+
+private:
+    float dcOffset{ antiDenormal };
+    float noiseScale{ 0.0f };
+    juce::uint32 seed{ 1 };
+};
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+    GoldenRender.cpp
+    Created: 19 Oct 2026 2:48:05am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "GoldenRender.h"
+
+void GoldenRender::makeSignal(juce::AudioBuffer<float>& buffer, Signal signal, double sampleRate, int seed)
+{
+    buffer.clear();
+    const auto numSamples = buffer.getNumSamples();
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        auto* data = buffer.getWritePointer(channel);
+
+        if (signal == Signal::noise)
+        {
+            juce::Random random(seed + channel);
+
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = (random.nextFloat() * 2.0f - 1.0f) * 0.5f;
+        }
+        else if (signal == Signal::sweep)
+        {
+            // An exponential sweep from 20Hz to 20kHz over the whole length, at -6dB.
+            const auto duration = (double)numSamples / sampleRate;
+            const auto rate = std::log(20000.0 / 20.0);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto t = (double)i / sampleRate;
+                const auto phase = juce::MathConstants<double>::twoPi * 20.0 * duration / rate * (std::exp(t * rate / duration) - 1.0);
+                data[i] = (float)(0.5 * std::sin(phase));
+            }
+        }
+        else if (numSamples > 0)
+        {
+            // A single full scale sample, then the rest is left for the tail.
+            data[0] = 1.0f;
+        }
+    }
+}
+
+juce::AudioBuffer<float> GoldenRender::render(juce::AudioProcessor& processor, Signal signal, const Settings& settings,
+                                              double& nanosecondsPerSample)
+{
+    const auto numSamples = juce::jmax(1, (int)(settings.seconds * settings.sampleRate));
+    const auto numInputs = processor.getTotalNumInputChannels();
+    const auto numOutputs = processor.getTotalNumOutputChannels();
+    const auto numChannels = juce::jmax(numInputs, numOutputs);
+
+    // The signal only goes into the inputs, the outputs past them start as silence like they would from a host.
+    juce::AudioBuffer<float> buffer(numChannels, numSamples);
+    makeSignal(buffer, signal, settings.sampleRate, settings.seed);
+
+    for (int channel = numInputs; channel < numChannels; ++channel)
+        buffer.clear(channel, 0, numSamples);
+
+    processor.setRateAndBufferSizeDetails(settings.sampleRate, settings.blockSize);
+    processor.prepareToPlay(settings.sampleRate, settings.blockSize);
+
+    // The block refers into the whole buffer, so the render is done in place and only processBlock gets timed.
+    juce::AudioBuffer<float> block;
+    juce::MidiBuffer midi;
+    juce::int64 ticks = 0;
+
+    for (int start = 0; start < numSamples; start += settings.blockSize)
+    {
+        const auto length = juce::jmin(settings.blockSize, numSamples - start);
+        block.setDataToReferTo(buffer.getArrayOfWritePointers(), numChannels, start, length);
+        midi.clear();
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        processor.processBlock(block, midi);
+        ticks += juce::Time::getHighResolutionTicks() - startTicks;
+    }
+
+    processor.releaseResources();
+
+    const auto seconds = juce::Time::highResolutionTicksToSeconds(ticks);
+    nanosecondsPerSample = seconds * 1.0e9 / ((double)numSamples * (double)juce::jmax(1, numOutputs));
+
+    buffer.setSize(numOutputs, numSamples, true);
+    return buffer;
+}
+
+GoldenRender::Result GoldenRender::check(juce::AudioProcessor& processor, Signal signal, const juce::File& referenceFolder,
+                                         Tolerance tolerance, const Settings& settings, bool updateReferences)
+{
+    Result result;
+
+    const auto output = render(processor, signal, settings, result.nanosecondsPerSample);
+    result.realtimeFactor = result.nanosecondsPerSample > 0.0
+                          ? 1.0e9 / (result.nanosecondsPerSample * juce::jmax(1, output.getNumChannels()) * settings.sampleRate)
+                          : 0.0;
+
+    const auto name = processor.getName().removeCharacters(" ") + "_" + getSignalName(signal);
+    const auto referenceFile = referenceFolder.getChildFile(name + ".wav");
+
+    if (updateReferences || ! referenceFile.existsAsFile())
+    {
+        referenceFolder.createDirectory();
+        result.stored = writeWav(output, settings.sampleRate, referenceFile);
+        result.matched = result.stored;
+
+        if (! result.stored)
+            result.error = "couldn't write " + referenceFile.getFullPathName();
+
+        return result;
+    }
+
+    juce::AudioBuffer<float> reference;
+
+    if (! readWav(referenceFile, reference))
+    {
+        result.error = "couldn't read " + referenceFile.getFullPathName();
+        return result;
+    }
+
+    if (! compare(output, reference, tolerance, result))
+        writeWav(output, settings.sampleRate, referenceFolder.getChildFile(name + ".failed.wav"));
+
+    return result;
+}
+
+juce::String GoldenRender::run(juce::AudioProcessor& processor, const juce::File& referenceFolder,
+                               Tolerance tolerance, const Settings& settings, bool updateReferences, bool* allMatched)
+{
+    juce::String report;
+
+    for (auto signal : { Signal::noise, Signal::sweep, Signal::impulse })
+    {
+        const auto result = check(processor, signal, referenceFolder, tolerance, settings, updateReferences);
+
+        if (allMatched != nullptr && ! result.matched)
+            *allMatched = false;
+
+        report << (processor.getName() + " " + getSignalName(signal)).paddedRight(' ', 32);
+
+        if (result.error.isNotEmpty())
+            report << "FAILED " << result.error;
+        else if (result.stored)
+            report << "stored";
+        else
+            report << (result.matched ? "matched" : "DIFFERENT")
+                   << " (worst " << juce::String(result.worstUlps) << " ulps, "
+                   << juce::String(result.worstDifferenceDecibels, 1) << " dB)";
+
+        report << "   " << juce::String(result.nanosecondsPerSample, 2) << " ns per sample, "
+               << juce::String(result.realtimeFactor, 0) << "x real time" << juce::newLine;
+    }
+
+    return report;
+}
+
+int64_t GoldenRender::ulpsBetween(float a, float b)
+{
+    // Flips the negative floats round so the bit patterns count up in the same order as the values,
+    // with -0 and +0 both landing on 0.
+    auto toOrdered = [](float value)
+    {
+        int32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits < 0 ? (int64_t)std::numeric_limits<int32_t>::min() - bits : (int64_t)bits;
+    };
+
+    return std::abs(toOrdered(a) - toOrdered(b));
+}
+
+bool GoldenRender::compare(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& reference,
+                           Tolerance tolerance, Result& result)
+{
+    if (output.getNumChannels() != reference.getNumChannels() || output.getNumSamples() != reference.getNumSamples())
+    {
+        result.matched = false;
+        result.error = "the reference is " + juce::String(reference.getNumChannels()) + " channels of "
+                     + juce::String(reference.getNumSamples()) + " samples";
+        return false;
+    }
+
+    auto worstDifference = 0.0f;
+    auto peak = 0.0f;
+    result.worstUlps = 0;
+
+    for (int channel = 0; channel < output.getNumChannels(); ++channel)
+    {
+        const auto* out = output.getReadPointer(channel);
+        const auto* ref = reference.getReadPointer(channel);
+
+        for (int i = 0; i < output.getNumSamples(); ++i)
+        {
+            result.worstUlps = juce::jmax(result.worstUlps, ulpsBetween(out[i], ref[i]));
+            worstDifference = juce::jmax(worstDifference, std::abs(out[i] - ref[i]));
+            peak = juce::jmax(peak, std::abs(ref[i]));
+        }
+    }
+
+    result.worstDifferenceDecibels = worstDifference > 0.0f
+                                   ? 20.0f * std::log10(worstDifference / juce::jmax(peak, 1.0e-30f))
+                                   : -std::numeric_limits<float>::infinity();
+
+    result.matched = result.worstUlps <= tolerance.maxUlps || result.worstDifferenceDecibels <= tolerance.maxDifferenceDecibels;
+    return result.matched;
+}
+
+juce::String GoldenRender::getSignalName(Signal signal)
+{
+    switch (signal)
+    {
+        case Signal::noise:   return "noise";
+        case Signal::sweep:   return "sweep";
+        case Signal::impulse: return "impulse";
+    }
+
+    return {};
+}
+
+bool GoldenRender::writeWav(const juce::AudioBuffer<float>& buffer, double sampleRate, const juce::File& file)
+{
+    // 32 bit WAVs are floats, so the output goes in without any rounding and can be compared bit for bit.
+    file.deleteFile();
+    auto stream = file.createOutputStream();
+
+    if (stream == nullptr)
+        return false;
+
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(stream.get(), sampleRate,
+                                                                           (unsigned int)buffer.getNumChannels(), 32, {}, 0));
+
+    if (writer == nullptr)
+        return false;
+
+    // The writer owns the stream now.
+    stream.release();
+    return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+}
+
+bool GoldenRender::readWav(const juce::File& file, juce::AudioBuffer<float>& buffer)
+{
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatReader> reader(format.createReaderFor(file.createInputStream().release(), true));
+
+    if (reader == nullptr)
+        return false;
+
+    buffer.setSize((int)reader->numChannels, (int)reader->lengthInSamples);
+    return reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+}
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    GoldenRender.h
+    Created: 19 Oct 2026 2:48:05am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Renders fixed, seeded signals through a processor offline and checks the output against reference WAVs from an
+// earlier build, so an optimisation can be shown not to have changed the sound. The first run, or one with
+// updateReferences set, stores the references instead. Each render is timed around processBlock only, so the
+// speed and whether it still matches come out of the same run.
+// The processor is rendered at whatever its parameters are set to, which should be its defaults for the references
+// to mean anything. Anything it works out on the shared worker pool lands on a different block each run, so
+// those features have to be off too.
+class GoldenRender
+{
+public:
+    enum class Signal { noise, sweep, impulse };
+
+    // How close the output has to be. A sample passes if it is within maxUlps of the reference, or the whole render
+    // passes if its worst difference is at least maxDifferenceDecibels below the reference's peak.
+    struct Tolerance
+    {
+        int maxUlps{ 0 };
+        float maxDifferenceDecibels{ -std::numeric_limits<float>::infinity() };
+
+        static Tolerance bitExact() { return {}; }
+
+        // For SIMD or fast-math versions of a kernel, which round differently but shouldn't be audibly different.
+        static Tolerance approximate() { return { 16, -120.0f }; }
+    };
+
+    struct Settings
+    {
+        double sampleRate{ 48000.0 };
+        int blockSize{ 512 };
+        double seconds{ 2.0 };
+        int seed{ 1234 };
+    };
+
+    struct Result
+    {
+        bool matched{ false };
+        bool stored{ false };
+        juce::String error;
+
+        int64_t worstUlps{ 0 };
+        float worstDifferenceDecibels{ -std::numeric_limits<float>::infinity() };
+
+        // Per sample per channel, and how many times faster than real time the whole render went.
+        double nanosecondsPerSample{ 0.0 };
+        double realtimeFactor{ 0.0 };
+    };
+
+    // Fills every channel, noise gets a different seed on each so the channels aren't identical.
+    static void makeSignal(juce::AudioBuffer<float>& buffer, Signal signal, double sampleRate, int seed);
+
+    // Runs the signal through the processor in blocks of blockSize and times it.
+    static juce::AudioBuffer<float> render(juce::AudioProcessor& processor, Signal signal, const Settings& settings,
+                                           double& nanosecondsPerSample);
+
+    // Renders the signal and compares it with referenceFolder/<name>_<signal>.wav. When it doesn't match, the output
+    // is written next to the reference with .failed on the end so the two can be listened to.
+    static Result check(juce::AudioProcessor& processor, Signal signal, const juce::File& referenceFolder,
+                        Tolerance tolerance = Tolerance::bitExact(), const Settings& settings = {},
+                        bool updateReferences = false);
+
+    // Checks every signal and reports one line for each. allMatched, if given, is cleared when any of them
+    // didn't match or couldn't be checked, and left alone otherwise so it can be carried across processors.
+    static juce::String run(juce::AudioProcessor& processor, const juce::File& referenceFolder,
+                            Tolerance tolerance = Tolerance::bitExact(), const Settings& settings = {},
+                            bool updateReferences = false, bool* allMatched = nullptr);
+
+    // How many floats apart two values are, 0 when they are identical bit for bit.
+    static int64_t ulpsBetween(float a, float b);
+
+    // Compares two renders, false with the reason in result.error if their sizes don't match.
+    static bool compare(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& reference,
+                        Tolerance tolerance, Result& result);
+
+    static juce::String getSignalName(Signal signal);
+
+private:
+    static bool writeWav(const juce::AudioBuffer<float>& buffer, double sampleRate, const juce::File& file);
+    static bool readWav(const juce::File& file, juce::AudioBuffer<float>& buffer);
+};
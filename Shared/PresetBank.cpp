@@ -0,0 +1,279 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 18 Oct 2026 1:15:36pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+PresetBank::PresetBank(juce::AudioProcessor& p, juce::AudioProcessorValueTreeState* state) : processor(p)
+{
+    if (state == nullptr)
+        return;
+
+    for (auto* parameter : processor.getParameters())
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        plainValues.push_back(ranged != nullptr ? state->getRawParameterValue(ranged->paramID) : nullptr);
+    }
+}
+
+PresetBank::~PresetBank()
+{
+    cancelPendingUpdate();
+}
+
+void PresetBank::ensureLoaded()
+{
+    if (isLoaded)
+        return;
+
+    bankFile = getDefaultBankFile(processor.getName());
+
+    if (loadFromFile(bankFile))
+        return;
+
+    // The host may have restored a session by now, so the default preset is built from the defaults
+    // rather than whatever the parameters are currently set to.
+    auto preset = std::make_unique<Preset>();
+    preset->name = "Default";
+
+    for (auto* parameter : processor.getParameters())
+        preset->values.push_back(parameter->getDefaultValue());
+
+    presets.add(preset.release());
+}
+
+bool PresetBank::loadFromFile(const juce::File& file)
+{
+    // The audio thread could be holding one of the current presets, so a bank can only be loaded once.
+    jassert(presets.isEmpty());
+    isLoaded = true;
+
+    if (! file.existsAsFile())
+        return false;
+
+    // Mapping the file means the bank is read straight from the page cache without copying it first.
+    juce::MemoryMappedFile mappedFile(file, juce::MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() == nullptr)
+        return false;
+
+    juce::MemoryInputStream stream(mappedFile.getData(), mappedFile.getSize(), false);
+
+    if ((juce::uint32)stream.readInt() != magicNumber || (juce::uint16)stream.readShort() > currentVersion)
+        return false;
+
+    const auto numPresets = (int)(juce::uint16)stream.readShort();
+    const auto* bytes = static_cast<const char*>(mappedFile.getData());
+
+    for (int i = 0; i < numPresets && ! stream.isExhausted(); ++i)
+    {
+        // Each preset is its name followed by a state written by the StateSerializer.
+        const auto nameLength = (int)(juce::uint8)stream.readByte();
+        auto name = juce::String::fromUTF8(bytes + stream.getPosition(), nameLength);
+        stream.skipNextBytes(nameLength);
+
+        const auto stateSize = stream.readInt();
+
+        if (stateSize < 0 || stream.getNumBytesRemaining() < stateSize)
+            break;
+
+        auto preset = std::make_unique<Preset>();
+        preset->name = name;
+
+        if (StateSerializer::decode(processor, bytes + stream.getPosition(), stateSize, preset->values))
+            presets.add(preset.release());
+
+        stream.skipNextBytes(stateSize);
+    }
+
+    return ! presets.isEmpty();
+}
+
+bool PresetBank::saveToFile(const juce::File& file) const
+{
+    juce::MemoryBlock bank;
+
+    {
+        juce::MemoryOutputStream stream(bank, false);
+        stream.writeInt((int)magicNumber);
+        stream.writeShort((short)currentVersion);
+        stream.writeShort((short)presets.size());
+
+        for (auto* preset : presets)
+        {
+            // Parameters the preset doesn't mention are stored with their current value.
+            auto values = preset->values;
+            const auto& parameters = processor.getParameters();
+
+            for (size_t i = 0; i < values.size(); ++i)
+                if (std::isnan(values[i]))
+                    values[i] = parameters[(int)i]->getValue();
+
+            juce::MemoryBlock state;
+            StateSerializer::encode(processor, values, state);
+
+            const auto* name = preset->name.toRawUTF8();
+            const auto nameLength = juce::jmin((int)std::strlen(name), 255);
+
+            stream.writeByte((char)nameLength);
+            stream.write(name, (size_t)nameLength);
+            stream.writeInt((int)state.getSize());
+            stream.write(state.getData(), state.getSize());
+        }
+    }
+
+    return file.getParentDirectory().createDirectory() && file.replaceWithData(bank.getData(), bank.getSize());
+}
+
+juce::File PresetBank::getDefaultBankFile(const juce::String& pluginName)
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("Almost Music")
+        .getChildFile(pluginName + ".presets");
+}
+
+void PresetBank::addPresetFromCurrentState(const juce::String& name)
+{
+    ensureLoaded();
+
+    auto preset = std::make_unique<Preset>();
+    preset->name = name;
+
+    for (auto* parameter : processor.getParameters())
+        preset->values.push_back(parameter->getValue());
+
+    presets.add(preset.release());
+}
+
+int PresetBank::getNumPresets()
+{
+    ensureLoaded();
+    return presets.size();
+}
+
+int PresetBank::getCurrentPreset() const
+{
+    return currentPreset.load();
+}
+
+juce::String PresetBank::getPresetName(int index)
+{
+    ensureLoaded();
+
+    if (auto* preset = presets[index])
+        return preset->name;
+
+    return {};
+}
+
+void PresetBank::renamePreset(int index, const juce::String& newName)
+{
+    ensureLoaded();
+
+    // The audio thread never looks at the name so this is safe to change at any time.
+    if (auto* preset = presets[index])
+    {
+        preset->name = newName;
+
+        if (bankFile != juce::File())
+            saveToFile(bankFile);
+    }
+}
+
+void PresetBank::selectPreset(int index)
+{
+    ensureLoaded();
+    auto* preset = presets[index];
+
+    if (preset == nullptr)
+        return;
+
+    currentPreset = index;
+
+    // With no audio running nothing would pick the preset up, so it is applied straight away.
+    if (! isPlaying.load())
+    {
+        StateSerializer::apply(processor, preset->values);
+        return;
+    }
+
+    pendingPreset.store(preset);
+}
+
+void PresetBank::prepareToPlay(double sampleRate)
+{
+    fadeLengthSamples = juce::jmax(1, (int)(sampleRate * 0.005));
+    fadeState = FadeState::idle;
+    presetToApply = nullptr;
+
+    // A preset selected while stopped has already been applied.
+    pendingPreset.store(nullptr);
+    isPlaying = true;
+}
+
+void PresetBank::releaseResources()
+{
+    isPlaying = false;
+
+    // Anything still waiting is applied now, since there won't be another block to do it.
+    if (auto* preset = presetToApply != nullptr ? presetToApply : pendingPreset.exchange(nullptr))
+        StateSerializer::apply(processor, preset->values);
+
+    presetToApply = nullptr;
+    fadeState = FadeState::idle;
+}
+
+void PresetBank::beginBlock()
+{
+    if (fadeState == FadeState::fadedOut && presetToApply != nullptr)
+    {
+        // The output finished fading out at the end of the last block, so the jump is silent.
+        // This block already reads the new values, telling the host takes its lock so that is left to the message thread.
+        StateSerializer::applyWithoutNotifying(processor, presetToApply->values, plainValues);
+
+        appliedPreset.store(presetToApply);
+        triggerAsyncUpdate();
+
+        presetToApply = nullptr;
+        fadeState = FadeState::fadingIn;
+    }
+}
+
+void PresetBank::endBlock(juce::AudioBuffer<float>& buffer)
+{
+    const auto numSamples = buffer.getNumSamples();
+    const auto fadeSamples = juce::jmin(fadeLengthSamples, numSamples);
+
+    if (fadeState == FadeState::fadingIn)
+    {
+        // Bring the new preset in over the start of the block.
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            buffer.applyGainRamp(channel, 0, fadeSamples, 0.0f, 1.0f);
+
+        fadeState = FadeState::idle;
+    }
+    else if (fadeState == FadeState::idle)
+    {
+        if (auto* preset = pendingPreset.exchange(nullptr))
+        {
+            // Fade out over the end of this block, the preset is applied at the start of the next one.
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                buffer.applyGainRamp(channel, numSamples - fadeSamples, fadeSamples, 1.0f, 0.0f);
+
+            presetToApply = preset;
+            fadeState = FadeState::fadedOut;
+        }
+    }
+}
+
+void PresetBank::handleAsyncUpdate()
+{
+    if (auto* preset = appliedPreset.exchange(nullptr))
+        StateSerializer::notify(processor, preset->values);
+}
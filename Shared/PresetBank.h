@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 18 Oct 2026 1:15:36pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "StateSerializer.h"
+
+// Holds every preset of a plugin as a ready made snapshot of its parameter values.
+// The message thread queues a preset with a pointer swap and the audio thread picks it up
+// at the next block boundary, fading out and back in so the jump can't be heard.
+// The audio thread sets the values itself, including the value tree's copies so the next block already uses
+// them, and only telling the host and the parameters' listeners is left to the message thread.
+class PresetBank  : private juce::AsyncUpdater
+{
+public:
+    // Processors that read their parameters through a value tree pass it in, the same as for the SubBlockScheduler.
+    explicit PresetBank(juce::AudioProcessor& processor, juce::AudioProcessorValueTreeState* state = nullptr);
+    ~PresetBank() override;
+
+    // Maps the bank file into memory and builds a snapshot for every preset inside it. Message thread only.
+    // The bank in the users application data folder is loaded this way the first time anything asks about
+    // the presets, or a single default preset is made if there isn't one, so creating a plugin never reads it.
+    bool loadFromFile(const juce::File& file);
+    bool saveToFile(const juce::File& file) const;
+
+    // Where the bank for a plugin lives unless told otherwise.
+    static juce::File getDefaultBankFile(const juce::String& pluginName);
+
+    // Adds the current values of every parameter as a new preset. Message thread only.
+    void addPresetFromCurrentState(const juce::String& name);
+
+    int getNumPresets();
+    int getCurrentPreset() const;
+    juce::String getPresetName(int index);
+    void renamePreset(int index, const juce::String& newName);
+
+    // Queues a preset for the audio thread, this never blocks or allocates.
+    void selectPreset(int index);
+
+    void prepareToPlay(double sampleRate);
+    void releaseResources();
+
+    // Call at the top of processBlock, applies a preset once the output has faded out for it.
+    void beginBlock();
+
+    // Call at the end of processBlock, fades the output out ahead of a queued preset or back in after one.
+    void endBlock(juce::AudioBuffer<float>& buffer);
+
+    // "ALPB" when read as text.
+    static constexpr juce::uint32 magicNumber{ 0x42504c41 };
+    static constexpr juce::uint16 currentVersion{ 1 };
+
+private:
+    struct Preset
+    {
+        juce::String name;
+
+        // One normalised value per parameter of the processor, NaN leaves that parameter alone.
+        std::vector<float> values;
+    };
+
+    // Loads the default bank if nothing has been loaded yet. Message thread only.
+    void ensureLoaded();
+
+    // Tells the host and the listeners about the preset the audio thread just applied.
+    void handleAsyncUpdate() override;
+
+    juce::AudioProcessor& processor;
+    bool isLoaded{ false };
+
+    // The presets never move once created, so the audio thread can hold on to a pointer to one.
+    juce::OwnedArray<Preset> presets;
+
+    // Set by the message thread, taken by the audio thread.
+    std::atomic<Preset*> pendingPreset{ nullptr };
+
+    // The preset waiting for the fade out to finish before it is applied.
+    Preset* presetToApply{ nullptr };
+
+    // The preset the audio thread applied that the message thread still has to tell everyone about.
+    std::atomic<Preset*> appliedPreset{ nullptr };
+
+    // Where the value tree keeps each parameter's plain value, in the processor's order, or empty without one.
+    std::vector<std::atomic<float>*> plainValues;
+
+    enum class FadeState { idle, fadedOut, fadingIn };
+    FadeState fadeState{ FadeState::idle };
+
+    std::atomic<int> currentPreset{ 0 };
+    std::atomic<bool> isPlaying{ false };
+
+    // About 5ms of fade either side of the switch.
+    int fadeLengthSamples{ 256 };
+
+    // Where the bank was loaded from, renamed presets are written back to it.
+    juce::File bankFile;
+};
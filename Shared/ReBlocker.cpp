@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    ReBlocker.cpp
+    Created: 19 Oct 2026 1:05:33am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "ReBlocker.h"
+
+void ReBlocker::prepareToPlay(int newBlockSize, int numChannels, const Mode newMode)
+{
+    blockSize = juce::jmax(1, newBlockSize);
+    numPreparedChannels = juce::jmax(0, numChannels);
+    mode = newMode;
+
+    // Anything splitting a whole block into FFT partitions or SIMD registers relies on this.
+    jassert(mode == Mode::passthrough || juce::isPowerOfTwo(blockSize));
+
+    inputs.calloc((size_t)juce::jmax(1, numPreparedChannels));
+    outputs.calloc((size_t)juce::jmax(1, numPreparedChannels));
+
+    // Passthrough never touches the FIFOs, so it doesn't need any memory for them.
+    if (mode == Mode::passthrough)
+    {
+        arena.prepare(0);
+        return;
+    }
+
+    const auto requiredBytes = 2 * DspArena::getBufferSize(numPreparedChannels, blockSize);
+    arena.prepare(requiredBytes);
+
+    // Taken as one piece so it can come off the heap in one go as well, each FIFO still starts on a cache line.
+    auto* memory = arena.allocate<char>(requiredBytes, fallback);
+    const auto channelBytes = DspArena::getAlignedSize((size_t)blockSize * sizeof(float));
+
+    for (int channel = 0; channel < numPreparedChannels; ++channel)
+    {
+        inputs[channel] = reinterpret_cast<float*>(memory + (size_t)(2 * channel) * channelBytes);
+        outputs[channel] = reinterpret_cast<float*>(memory + (size_t)(2 * channel + 1) * channelBytes);
+    }
+
+    reset();
+}
+
+void ReBlocker::reset()
+{
+    fill = 0;
+
+    if (mode == Mode::passthrough)
+        return;
+
+    for (int channel = 0; channel < numPreparedChannels; ++channel)
+    {
+        juce::FloatVectorOperations::clear(inputs[channel], blockSize);
+        juce::FloatVectorOperations::clear(outputs[channel], blockSize);
+    }
+}
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    ReBlocker.h
+    Created: 19 Oct 2026 1:05:33am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DspArena.h"
+
+// Hands a DSP kernel blocks of a fixed size, whatever size the host calls processBlock with.
+//
+// Passthrough has no latency. The kernel gets the host's block in pieces no longer than the block size, which is
+// all that a kernel with per block scratch space needs. Fixed latency collects the input in a FIFO and only calls
+// the kernel once it has a whole block, so the kernel always sees exactly the block size, starting on a cache line,
+// which is what FFT partitions and kernels that want whole SIMD registers need. The output comes out one block late.
+class ReBlocker
+{
+public:
+    enum class Mode { passthrough, fixedLatency };
+
+    // In fixed latency the block size has to be a power of two, which is what FFT partitions need.
+    void prepareToPlay(int newBlockSize, int numChannels, const Mode newMode);
+    void reset();
+
+    int getBlockSize() const { return blockSize; }
+
+    // What the host has to be told about, none in passthrough. A caller that only looks at the signal, like the
+    // analyzer, can use it to line what it shows up with the audio instead.
+    int getLatencySamples() const { return mode == Mode::fixedLatency ? blockSize : 0; }
+
+    // Calls kernel(juce::dsp::AudioBlock<float>&) however many times the mode needs to get through the block.
+    // In fixed latency the block gets replaced with the output from one block ago.
+    template <typename Kernel>
+    void process(juce::dsp::AudioBlock<float>& block, Kernel&& kernel)
+    {
+        if (mode == Mode::passthrough)
+        {
+            forEachChunk(block, blockSize, kernel);
+            return;
+        }
+
+        const auto numChannels = juce::jmin(block.getNumChannels(), (size_t)numPreparedChannels);
+        size_t done = 0;
+
+        while (done < block.getNumSamples())
+        {
+            // As far as the end of the block, or until the FIFO is full.
+            const auto count = juce::jmin(block.getNumSamples() - done, (size_t)(blockSize - fill));
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* data = block.getChannelPointer(channel) + done;
+                juce::FloatVectorOperations::copy(inputs[channel] + fill, data, (int)count);
+                juce::FloatVectorOperations::copy(data, outputs[channel] + fill, (int)count);
+            }
+
+            fill += (int)count;
+            done += count;
+
+            if (fill == blockSize)
+            {
+                // The kernel works on the collected input in place, then it becomes the output for the next block
+                // and the old output is free to collect into. Swapping the pointers saves copying it over.
+                juce::dsp::AudioBlock<float> fullBlock{ inputs.get(), numChannels, (size_t)blockSize };
+                kernel(fullBlock);
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                    std::swap(inputs[channel], outputs[channel]);
+
+                fill = 0;
+            }
+        }
+    }
+
+    // The passthrough on its own, for anything that only needs its blocks kept under a size.
+    template <typename Kernel>
+    static void forEachChunk(juce::dsp::AudioBlock<float>& block, int maximumSize, Kernel&& kernel)
+    {
+        jassert(maximumSize > 0);
+
+        for (size_t start = 0; start < block.getNumSamples(); start += (size_t)maximumSize)
+        {
+            auto chunk = block.getSubBlock(start, juce::jmin((size_t)maximumSize, block.getNumSamples() - start));
+            kernel(chunk);
+        }
+    }
+
+private:
+    Mode mode{ Mode::passthrough };
+    int blockSize{ 512 };
+    int numPreparedChannels{ 0 };
+
+    // How much of the current block has been collected.
+    int fill{ 0 };
+
+    // Where the input is collected, and the output of the block before. Both point into the arena,
+    // or into fallback if the arena couldn't get its memory.
+    juce::HeapBlock<float*> inputs;
+    juce::HeapBlock<float*> outputs;
+    DspArena arena;
+    juce::HeapBlock<char> fallback;
+};
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    SilenceDetector.cpp
+    Created: 18 Oct 2026 6:02:15pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "SilenceDetector.h"
+
+void SilenceDetector::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    juce::ignoreUnused(samplesPerBlock);
+
+    hostSampleRate = sampleRate;
+    setTailLengthSeconds(tailLengthSeconds.load());
+
+    silentInputSamples = 0;
+    asleep = false;
+}
+
+void SilenceDetector::setTailLengthSeconds(double seconds)
+{
+    tailLengthSeconds = seconds;
+
+    // An infinite tail never runs out, so the detector never gets the chance to sleep.
+    tailSamples = std::isfinite(seconds) ? (juce::int64)std::ceil(juce::jmax(0.0, seconds) * hostSampleRate)
+                                         : std::numeric_limits<juce::int64>::max();
+}
+
+bool SilenceDetector::beginBlock(const juce::AudioBuffer<float>& buffer)
+{
+    if (! isSilent(buffer))
+    {
+        // Anything coming in wakes it up, the state was cleared when it fell asleep so it starts from nothing.
+        silentInputSamples = 0;
+        asleep = false;
+        return true;
+    }
+
+    if (silentInputSamples < tailSamples)
+        silentInputSamples += buffer.getNumSamples();
+
+    return ! asleep;
+}
+
+bool SilenceDetector::endBlock(const juce::AudioBuffer<float>& buffer)
+{
+    if (asleep || silentInputSamples < tailSamples)
+        return false;
+
+    // The tail should have died away by now, but the output has the final say.
+    asleep = isSilent(buffer);
+    return asleep;
+}
+
+bool SilenceDetector::isSilent(const juce::AudioBuffer<float>& buffer)
+{
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        // The peak is found with the widest registers this machine has, which is a lot quicker than checking
+        // each sample against the threshold.
+        if (SimdKernels::get().findPeak(buffer.getReadPointer(channel), buffer.getNumSamples()) > silenceThreshold)
+            return false;
+    }
+
+    return true;
+}
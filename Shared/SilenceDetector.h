@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    SilenceDetector.h
+    Created: 18 Oct 2026 6:02:15pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SimdKernels.h"
+
+// Lets a processor go to sleep while nothing is coming in and nothing is left ringing out.
+// Once the input has been below -120dB for longer than the tail, and the output is down there too,
+// beginBlock() returns false and the processor can output zeros without running any of its DSP.
+// It only ever falls asleep when the output is already silent, and any input wakes it straight
+// back up from a cleared state, so neither direction makes a click.
+class SilenceDetector
+{
+public:
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+
+    // How long the processor keeps making sound after its input stops. Infinity keeps it awake for good.
+    void setTailLengthSeconds(double seconds);
+    double getTailLengthSeconds() const { return tailLengthSeconds.load(); }
+
+    // Looks at the input and returns whether the block needs processing at all.
+    bool beginBlock(const juce::AudioBuffer<float>& buffer);
+
+    // Looks at the processed output. Returns true on the block it falls asleep, which is when the
+    // processor should reset its state so nothing is left over when it wakes.
+    bool endBlock(const juce::AudioBuffer<float>& buffer);
+
+    bool isAsleep() const { return asleep; }
+
+    // True when every sample of every channel is below the threshold.
+    static bool isSilent(const juce::AudioBuffer<float>& buffer);
+
+    // -120dB
+    static constexpr float silenceThreshold{ 1.0e-6f };
+
+private:
+    double hostSampleRate{ 44100.0 };
+
+    std::atomic<double> tailLengthSeconds{ 0.0 };
+
+    // How many samples the input has to stay silent for before the output can be trusted to stay silent.
+    juce::int64 tailSamples{ 0 };
+    juce::int64 silentInputSamples{ 0 };
+
+    bool asleep{ false };
+};
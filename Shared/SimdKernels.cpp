@@ -0,0 +1,468 @@
+/*
+  ==============================================================================
+
+    SimdKernels.cpp
+    Created: 19 Oct 2026 3:26:18am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "SimdKernels.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+
+ // GCC and Clang only let a function use an instruction set the whole file wasn't built for when it is marked with it.
+ // MSVC lets any function use any intrinsic, so there is nothing to mark.
+ #if defined (__GNUC__)
+  #include <cpuid.h>
+  #define SIMD_KERNELS_SSE2   __attribute__((target("sse2")))
+  #define SIMD_KERNELS_AVX2   __attribute__((target("avx2")))
+  #define SIMD_KERNELS_AVX512 __attribute__((target("avx512f")))
+ #else
+  #include <intrin.h>
+  #define SIMD_KERNELS_SSE2
+  #define SIMD_KERNELS_AVX2
+  #define SIMD_KERNELS_AVX512
+ #endif
+#endif
+
+namespace
+{
+    // One sample of each kernel. The generic versions are just these in a loop, and the SIMD versions use them for
+    // whatever is left over at the end, so the last few samples come out the same as the rest.
+    inline float foldSample(float signal, float threshold, float inverseThreshold, float drive)
+    {
+        const auto driven = signal * drive;
+        const auto trips = juce::jmin(std::abs(driven) * inverseThreshold, 1.0e6f);
+        const auto position = trips - (float)(int)(trips * 0.5f) * 2.0f;
+        const auto folded = threshold * (1.0f - std::abs(1.0f - position));
+        return driven < 0.0f ? -folded : folded;
+    }
+
+    namespace generic
+    {
+        void fold(float* data, int numSamples, float threshold, float inverseThreshold, float drive)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = foldSample(data[i], threshold, inverseThreshold, drive);
+        }
+
+        float findPeak(const float* data, int numSamples)
+        {
+            auto peak = 0.0f;
+
+            for (int i = 0; i < numSamples; ++i)
+                peak = juce::jmax(peak, std::abs(data[i]));
+
+            return peak;
+        }
+
+        void multiplyByCurve(float* data, const float* gains, int numSamples, float gain)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] *= gains[i] * gain;
+        }
+
+        void multiplyByCurves(float* data, const float* gains, const float* moreGains, int numSamples, float gain)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] *= gains[i] * moreGains[i] * gain;
+        }
+
+        void addWithMultiply(float* destination, const float* source, int numSamples, float gain)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] += source[i] * gain;
+        }
+    }
+
+   #if JUCE_INTEL
+    namespace sse2
+    {
+        constexpr int width = 4;
+
+        SIMD_KERNELS_SSE2 void fold(float* data, int numSamples, float threshold, float inverseThreshold, float drive)
+        {
+            const auto absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            const auto one = _mm_set1_ps(1.0f);
+            const auto t = _mm_set1_ps(threshold);
+            const auto inverse = _mm_set1_ps(inverseThreshold);
+            const auto d = _mm_set1_ps(drive);
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+            {
+                const auto driven = _mm_mul_ps(_mm_loadu_ps(data + i), d);
+                const auto trips = _mm_min_ps(_mm_mul_ps(_mm_and_ps(driven, absMask), inverse), _mm_set1_ps(1.0e6f));
+                const auto whole = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(trips, _mm_set1_ps(0.5f))));
+                const auto position = _mm_sub_ps(trips, _mm_mul_ps(whole, _mm_set1_ps(2.0f)));
+                const auto folded = _mm_mul_ps(t, _mm_sub_ps(one, _mm_and_ps(_mm_sub_ps(one, position), absMask)));
+                const auto isNegative = _mm_cmplt_ps(driven, _mm_setzero_ps());
+                _mm_storeu_ps(data + i, _mm_sub_ps(folded, _mm_and_ps(_mm_add_ps(folded, folded), isNegative)));
+            }
+
+            generic::fold(data + i, numSamples - i, threshold, inverseThreshold, drive);
+        }
+
+        SIMD_KERNELS_SSE2 float findPeak(const float* data, int numSamples)
+        {
+            const auto absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            auto peaks = _mm_setzero_ps();
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+                peaks = _mm_max_ps(peaks, _mm_and_ps(_mm_loadu_ps(data + i), absMask));
+
+            alignas(16) float lanes[width];
+            _mm_store_ps(lanes, peaks);
+
+            auto peak = generic::findPeak(data + i, numSamples - i);
+
+            for (auto lane : lanes)
+                peak = juce::jmax(peak, lane);
+
+            return peak;
+        }
+
+        SIMD_KERNELS_SSE2 void multiplyByCurve(float* data, const float* gains, int numSamples, float gain)
+        {
+            const auto g = _mm_set1_ps(gain);
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+                _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), _mm_mul_ps(_mm_loadu_ps(gains + i), g)));
+
+            generic::multiplyByCurve(data + i, gains + i, numSamples - i, gain);
+        }
+
+        SIMD_KERNELS_SSE2 void multiplyByCurves(float* data, const float* gains, const float* moreGains, int numSamples, float gain)
+        {
+            const auto g = _mm_set1_ps(gain);
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+            {
+                const auto curve = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(gains + i), _mm_loadu_ps(moreGains + i)), g);
+                _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), curve));
+            }
+
+            generic::multiplyByCurves(data + i, gains + i, moreGains + i, numSamples - i, gain);
+        }
+
+        SIMD_KERNELS_SSE2 void addWithMultiply(float* destination, const float* source, int numSamples, float gain)
+        {
+            const auto g = _mm_set1_ps(gain);
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+                _mm_storeu_ps(destination + i, _mm_add_ps(_mm_loadu_ps(destination + i), _mm_mul_ps(_mm_loadu_ps(source + i), g)));
+
+            generic::addWithMultiply(destination + i, source + i, numSamples - i, gain);
+        }
+    }
+
+    namespace avx2
+    {
+        constexpr int width = 8;
+
+        SIMD_KERNELS_AVX2 void fold(float* data, int numSamples, float threshold, float inverseThreshold, float drive)
+        {
+            const auto absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+            const auto one = _mm256_set1_ps(1.0f);
+            const auto t = _mm256_set1_ps(threshold);
+            const auto inverse = _mm256_set1_ps(inverseThreshold);
+            const auto d = _mm256_set1_ps(drive);
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+            {
+                const auto driven = _mm256_mul_ps(_mm256_loadu_ps(data + i), d);
+                const auto trips = _mm256_min_ps(_mm256_mul_ps(_mm256_and_ps(driven, absMask), inverse), _mm256_set1_ps(1.0e6f));
+                const auto whole = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_mul_ps(trips, _mm256_set1_ps(0.5f))));
+                const auto position = _mm256_sub_ps(trips, _mm256_mul_ps(whole, _mm256_set1_ps(2.0f)));
+                const auto folded = _mm256_mul_ps(t, _mm256_sub_ps(one, _mm256_and_ps(_mm256_sub_ps(one, position), absMask)));
+                const auto isNegative = _mm256_cmp_ps(driven, _mm256_setzero_ps(), _CMP_LT_OQ);
+                _mm256_storeu_ps(data + i, _mm256_sub_ps(folded, _mm256_and_ps(_mm256_add_ps(folded, folded), isNegative)));
+            }
+
+            sse2::fold(data + i, numSamples - i, threshold, inverseThreshold, drive);
+        }
+
+        SIMD_KERNELS_AVX2 float findPeak(const float* data, int numSamples)
+        {
+            const auto absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+            auto peaks = _mm256_setzero_ps();
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+                peaks = _mm256_max_ps(peaks, _mm256_and_ps(_mm256_loadu_ps(data + i), absMask));
+
+            alignas(32) float lanes[width];
+            _mm256_store_ps(lanes, peaks);
+
+            auto peak = sse2::findPeak(data + i, numSamples - i);
+
+            for (auto lane : lanes)
+                peak = juce::jmax(peak, lane);
+
+            return peak;
+        }
+
+        SIMD_KERNELS_AVX2 void multiplyByCurve(float* data, const float* gains, int numSamples, float gain)
+        {
+            const auto g = _mm256_set1_ps(gain);
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+                _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), _mm256_mul_ps(_mm256_loadu_ps(gains + i), g)));
+
+            sse2::multiplyByCurve(data + i, gains + i, numSamples - i, gain);
+        }
+
+        SIMD_KERNELS_AVX2 void multiplyByCurves(float* data, const float* gains, const float* moreGains, int numSamples, float gain)
+        {
+            const auto g = _mm256_set1_ps(gain);
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+            {
+                const auto curve = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(gains + i), _mm256_loadu_ps(moreGains + i)), g);
+                _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), curve));
+            }
+
+            sse2::multiplyByCurves(data + i, gains + i, moreGains + i, numSamples - i, gain);
+        }
+
+        SIMD_KERNELS_AVX2 void addWithMultiply(float* destination, const float* source, int numSamples, float gain)
+        {
+            const auto g = _mm256_set1_ps(gain);
+            int i = 0;
+
+            for (; i + width <= numSamples; i += width)
+                _mm256_storeu_ps(destination + i, _mm256_add_ps(_mm256_loadu_ps(destination + i), _mm256_mul_ps(_mm256_loadu_ps(source + i), g)));
+
+            sse2::addWithMultiply(destination + i, source + i, numSamples - i, gain);
+        }
+    }
+
+    namespace avx512
+    {
+        constexpr int width = 16;
+
+        // AVX-512 can mask off the lanes past the end, so the last few samples go through the same instructions as
+        // the rest rather than a scalar loop, which GCC would be free to turn into FMAs here.
+        SIMD_KERNELS_AVX512 inline __mmask16 getMask(int i, int numSamples)
+        {
+            const auto remaining = numSamples - i;
+            return remaining >= width ? (__mmask16)0xffff : (__mmask16)((1u << remaining) - 1u);
+        }
+
+        // GCC fuses a multiply followed by an add into an FMA, which only rounds once, so the product is hidden from it.
+        SIMD_KERNELS_AVX512 inline __m512 keepRounded(__m512 product)
+        {
+           #if defined (__GNUC__)
+            __asm__ ("" : "+v" (product));
+           #endif
+            return product;
+        }
+
+        SIMD_KERNELS_AVX512 void fold(float* data, int numSamples, float threshold, float inverseThreshold, float drive)
+        {
+            const auto one = _mm512_set1_ps(1.0f);
+            const auto t = _mm512_set1_ps(threshold);
+            const auto inverse = _mm512_set1_ps(inverseThreshold);
+            const auto d = _mm512_set1_ps(drive);
+
+            for (int i = 0; i < numSamples; i += width)
+            {
+                const auto mask = getMask(i, numSamples);
+                const auto driven = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, data + i), d);
+                const auto trips = _mm512_min_ps(_mm512_mul_ps(_mm512_abs_ps(driven), inverse), _mm512_set1_ps(1.0e6f));
+                const auto whole = _mm512_cvtepi32_ps(_mm512_cvttps_epi32(_mm512_mul_ps(trips, _mm512_set1_ps(0.5f))));
+                const auto position = _mm512_sub_ps(trips, keepRounded(_mm512_mul_ps(whole, _mm512_set1_ps(2.0f))));
+                const auto folded = _mm512_mul_ps(t, _mm512_sub_ps(one, _mm512_abs_ps(_mm512_sub_ps(one, position))));
+
+                // A mask register picks the negative lanes, which take folded - 2 * folded like the other versions.
+                const auto isNegative = _mm512_cmp_ps_mask(driven, _mm512_setzero_ps(), _CMP_LT_OQ);
+                _mm512_mask_storeu_ps(data + i, mask, _mm512_mask_sub_ps(folded, isNegative, folded, _mm512_add_ps(folded, folded)));
+            }
+        }
+
+        SIMD_KERNELS_AVX512 float findPeak(const float* data, int numSamples)
+        {
+            auto peaks = _mm512_setzero_ps();
+
+            for (int i = 0; i < numSamples; i += width)
+                peaks = _mm512_max_ps(peaks, _mm512_abs_ps(_mm512_maskz_loadu_ps(getMask(i, numSamples), data + i)));
+
+            return _mm512_reduce_max_ps(peaks);
+        }
+
+        SIMD_KERNELS_AVX512 void multiplyByCurve(float* data, const float* gains, int numSamples, float gain)
+        {
+            const auto g = _mm512_set1_ps(gain);
+
+            for (int i = 0; i < numSamples; i += width)
+            {
+                const auto mask = getMask(i, numSamples);
+                const auto curve = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, gains + i), g);
+                _mm512_mask_storeu_ps(data + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, data + i), curve));
+            }
+        }
+
+        SIMD_KERNELS_AVX512 void multiplyByCurves(float* data, const float* gains, const float* moreGains, int numSamples, float gain)
+        {
+            const auto g = _mm512_set1_ps(gain);
+
+            for (int i = 0; i < numSamples; i += width)
+            {
+                const auto mask = getMask(i, numSamples);
+                const auto curve = _mm512_mul_ps(_mm512_mul_ps(_mm512_maskz_loadu_ps(mask, gains + i), _mm512_maskz_loadu_ps(mask, moreGains + i)), g);
+                _mm512_mask_storeu_ps(data + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, data + i), curve));
+            }
+        }
+
+        SIMD_KERNELS_AVX512 void addWithMultiply(float* destination, const float* source, int numSamples, float gain)
+        {
+            const auto g = _mm512_set1_ps(gain);
+
+            for (int i = 0; i < numSamples; i += width)
+            {
+                const auto mask = getMask(i, numSamples);
+                const auto product = keepRounded(_mm512_mul_ps(_mm512_maskz_loadu_ps(mask, source + i), g));
+                _mm512_mask_storeu_ps(destination + i, mask, _mm512_add_ps(_mm512_maskz_loadu_ps(mask, destination + i), product));
+            }
+        }
+    }
+
+    void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int (&registers)[4])
+    {
+       #if defined (__GNUC__)
+        __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+       #else
+        int values[4];
+        __cpuidex(values, (int)leaf, (int)subleaf);
+
+        for (int i = 0; i < 4; ++i)
+            registers[i] = (unsigned int)values[i];
+       #endif
+    }
+
+    // Which register sets the operating system saves on a context switch. Only safe to ask once cpuid says it can be asked.
+    unsigned long long getEnabledRegisterState()
+    {
+       #if defined (__GNUC__)
+        unsigned int low, high;
+        __asm__ volatile ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+        return ((unsigned long long)high << 32) | low;
+       #else
+        return _xgetbv(0);
+       #endif
+    }
+   #endif
+
+    SimdKernels::Isa detectIsa()
+    {
+       #if JUCE_INTEL
+        unsigned int registers[4];
+
+        cpuid(0, 0, registers);
+        const auto highestLeaf = registers[0];
+
+        cpuid(1, 0, registers);
+        const auto hasSse2 = (registers[3] & (1u << 26)) != 0;
+        const auto hasXgetbv = (registers[2] & (1u << 27)) != 0;
+
+        if (! hasSse2)
+            return SimdKernels::Isa::generic;
+
+        if (! hasXgetbv || highestLeaf < 7)
+            return SimdKernels::Isa::sse2;
+
+        // The CPU having the instructions isn't enough, the OS also has to save the wider registers.
+        const auto state = getEnabledRegisterState();
+        const auto savesYmm = (state & 0x6) == 0x6;
+        const auto savesZmm = (state & 0xe6) == 0xe6;
+
+        cpuid(7, 0, registers);
+        const auto hasAvx2 = (registers[1] & (1u << 5)) != 0;
+        const auto hasAvx512 = (registers[1] & (1u << 16)) != 0;
+
+        if (hasAvx512 && savesZmm)
+            return SimdKernels::Isa::avx512;
+
+        if (hasAvx2 && savesYmm)
+            return SimdKernels::Isa::avx2;
+
+        return SimdKernels::Isa::sse2;
+       #else
+        return SimdKernels::Isa::generic;
+       #endif
+    }
+
+    const SimdKernels::Table genericTable{ SimdKernels::Isa::generic, generic::fold, generic::findPeak,
+                                           generic::multiplyByCurve, generic::multiplyByCurves, generic::addWithMultiply };
+
+   #if JUCE_INTEL
+    const SimdKernels::Table sse2Table{ SimdKernels::Isa::sse2, sse2::fold, sse2::findPeak,
+                                        sse2::multiplyByCurve, sse2::multiplyByCurves, sse2::addWithMultiply };
+
+    const SimdKernels::Table avx2Table{ SimdKernels::Isa::avx2, avx2::fold, avx2::findPeak,
+                                        avx2::multiplyByCurve, avx2::multiplyByCurves, avx2::addWithMultiply };
+
+    const SimdKernels::Table avx512Table{ SimdKernels::Isa::avx512, avx512::fold, avx512::findPeak,
+                                          avx512::multiplyByCurve, avx512::multiplyByCurves, avx512::addWithMultiply };
+   #endif
+
+    // Asks the CPU while the plugin is loading, so the audio thread never has to.
+    const auto& startupTable = SimdKernels::get();
+}
+
+const SimdKernels::Table& SimdKernels::get()
+{
+    static const Table& table = *getTable(getBestSupported());
+    return table;
+}
+
+SimdKernels::Isa SimdKernels::getBestSupported()
+{
+    static const auto best = detectIsa();
+    return best;
+}
+
+const SimdKernels::Table* SimdKernels::getTable(Isa isa)
+{
+    if ((int)isa > (int)getBestSupported())
+        return nullptr;
+
+    switch (isa)
+    {
+       #if JUCE_INTEL
+        case Isa::sse2:    return &sse2Table;
+        case Isa::avx2:    return &avx2Table;
+        case Isa::avx512:  return &avx512Table;
+       #else
+        case Isa::sse2:
+        case Isa::avx2:
+        case Isa::avx512:  return nullptr;
+       #endif
+        case Isa::generic: return &genericTable;
+    }
+
+    return nullptr;
+}
+
+juce::String SimdKernels::getName(Isa isa)
+{
+    switch (isa)
+    {
+        case Isa::generic: return "generic";
+        case Isa::sse2:    return "SSE2";
+        case Isa::avx2:    return "AVX2";
+        case Isa::avx512:  return "AVX-512";
+    }
+
+    return {};
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    SimdKernels.h
+    Created: 19 Oct 2026 3:26:18am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// The hot loops that don't carry anything from one sample to the next, built once for each instruction set and
+// picked when the plugin loads by asking the CPU with cpuid what it can do. One binary then uses AVX-512 or AVX2
+// where it is there and still runs on a machine that only has SSE2.
+// Every version does the same operations in the same order, and none of them use FMA, so they all give exactly
+// the same output, the same as the SIMDRegister and FloatVectorOperations code they replace.
+class SimdKernels
+{
+public:
+    enum class Isa { generic, sse2, avx2, avx512 };
+
+    struct Table
+    {
+        Isa isa;
+
+        // The wave folder from DistortionData, in place. Takes one over the threshold as well so nothing divides.
+        void (*fold)(float* data, int numSamples, float threshold, float inverseThreshold, float drive);
+
+        // The largest absolute value, 0 when there are no samples.
+        float (*findPeak)(const float* data, int numSamples);
+
+        // data *= gains * gain, and data *= gains * moreGains * gain, in that order.
+        void (*multiplyByCurve)(float* data, const float* gains, int numSamples, float gain);
+        void (*multiplyByCurves)(float* data, const float* gains, const float* moreGains, int numSamples, float gain);
+
+        // destination += source * gain, the multiply and add of a convolution tap.
+        void (*addWithMultiply)(float* destination, const float* source, int numSamples, float gain);
+    };
+
+    // The table for the best instruction set this machine has, worked out once.
+    static const Table& get();
+
+    // The table for a particular instruction set, or nullptr when it wasn't built in or the machine can't run it.
+    static const Table* getTable(Isa isa);
+
+    static Isa getBestSupported();
+    static juce::String getName(Isa isa);
+
+    // Times every kernel in every version this machine can run against the generic one, and checks they all match it.
+    // It is in SimdKernelsBenchmark.cpp, which only RenderCheck builds.
+    static juce::String runBenchmark(const int numSamples = 1 << 20);
+};
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    SimdKernelsBenchmark.cpp
+    Created: 19 Oct 2026 3:52:07am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "SimdKernels.h"
+
+// This is only built into RenderCheck, the plugins have no use for it.
+juce::String SimdKernels::runBenchmark(const int numSamples)
+{
+    const auto length = juce::jmax(16, numSamples);
+
+    // Random input over the range where the fold actually folds, plus a curve of gains and somewhere to put the output.
+    std::vector<float> input((size_t)length), gains((size_t)length), expected((size_t)length), output((size_t)length);
+    juce::Random random(1234);
+
+    for (int i = 0; i < length; ++i)
+    {
+        input[(size_t)i] = random.nextFloat() * 8.0f - 4.0f;
+        gains[(size_t)i] = random.nextFloat();
+    }
+
+    // Nanoseconds per sample for whatever the lambda does, starting from a fresh copy of the input each time.
+    auto time = [&](const Table& table, auto&& body)
+    {
+        std::copy(input.begin(), input.end(), output.begin());
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        body(table);
+        const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / (double)length;
+    };
+
+    juce::String report;
+    report << "Running " << getName(get().isa) << juce::newLine;
+
+    auto measure = [&](const juce::String& name, auto&& body)
+    {
+        report << name.paddedRight(' ', 18);
+
+        // The generic version sets what every other version has to match bit for bit.
+        const auto genericTime = time(*getTable(Isa::generic), body);
+        expected = output;
+
+        report << "generic " << juce::String(genericTime, 2) << " ns";
+
+        for (auto isa : { Isa::sse2, Isa::avx2, Isa::avx512 })
+        {
+            if (auto* table = getTable(isa))
+            {
+                const auto isaTime = time(*table, body);
+                const auto matches = std::memcmp(expected.data(), output.data(), sizeof(float) * (size_t)length) == 0;
+
+                report << "   " << getName(isa) << " " << juce::String(isaTime, 2) << " ns"
+                       << " (" << juce::String(genericTime / isaTime, 1) << "x" << (matches ? "" : ", DIFFERENT") << ")";
+            }
+        }
+
+        report << juce::newLine;
+    };
+
+    measure("fold", [&](const Table& table) { table.fold(output.data(), length, 0.7f, 1.0f / 0.7f, 1.5f); });
+    measure("peak", [&](const Table& table) { output[0] = table.findPeak(input.data(), length); });
+    measure("gain curve", [&](const Table& table) { table.multiplyByCurve(output.data(), gains.data(), length, 0.8f); });
+    measure("gain curves", [&](const Table& table) { table.multiplyByCurves(output.data(), gains.data(), input.data(), length, 0.8f); });
+    measure("multiply and add", [&](const Table& table) { table.addWithMultiply(output.data(), gains.data(), length, 0.3f); });
+
+    return report;
+}
@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 18 Oct 2026 4:40:03pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+void AnalyzerSource::prepareToPlay(double newSampleRate, int samplesPerBlock)
+{
+    sampleRate = newSampleRate;
+    scratch.setSize(1, juce::jmax(1, samplesPerBlock));
+    reBlocker.prepareToPlay(hopSize, 1, ReBlocker::Mode::fixedLatency);
+}
+
+void AnalyzerSource::push(const juce::AudioBuffer<float>& buffer)
+{
+    if (buffer.getNumChannels() == 0 || scratch.getNumSamples() == 0)
+        return;
+
+    const auto* data = buffer.getReadPointer(0);
+
+    // A host can send more than it said it would, so a big block goes through the scratch space in pieces.
+    for (int start = 0; start < buffer.getNumSamples(); start += scratch.getNumSamples())
+    {
+        const auto count = juce::jmin(scratch.getNumSamples(), buffer.getNumSamples() - start);
+        scratch.copyFrom(0, 0, data + start, count);
+
+        auto block = juce::dsp::AudioBlock<float>(scratch).getSubBlock(0, (size_t)count);
+        reBlocker.process(block, [this](juce::dsp::AudioBlock<float>& hop) { write(hop.getChannelPointer(0)); });
+    }
+}
+
+void AnalyzerSource::write(const float* hop)
+{
+    if (fifo.getFreeSpace() < hopSize)
+        return;
+
+    const auto scope = fifo.write(hopSize);
+    jassert(scope.blockSize1 == hopSize);
+
+    std::memcpy(samples + scope.startIndex1, hop, sizeof(float) * (size_t)hopSize);
+}
+
+int AnalyzerSource::pull(float* destination, int numSamples)
+{
+    const auto scope = fifo.read(juce::jmin(numSamples, fifo.getNumReady()));
+
+    if (scope.blockSize1 > 0)
+        std::memcpy(destination, samples + scope.startIndex1, sizeof(float) * (size_t)scope.blockSize1);
+
+    if (scope.blockSize2 > 0)
+        std::memcpy(destination + scope.blockSize1, samples + scope.startIndex2, sizeof(float) * (size_t)scope.blockSize2);
+
+    return scope.blockSize1 + scope.blockSize2;
+}
+
+//==============================================================================
+SpectrumAnalyzer::SpectrumAnalyzer(AnalyzerSource& s)
+    : source(s)
+{
+    setOpaque(true);
+    task = pool->submitRepeating([this](const WorkerPool::Task& t) { analyse(t); }, 10);
+    startTimerHz(30);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    stopTimer();
+    pool->cancelAndWait(task);
+}
+
+void SpectrumAnalyzer::paint(juce::Graphics& g)
+{
+    g.drawImageAt(background, 0, 0);
+
+    juce::Path path;
+    {
+        const juce::ScopedLock lock(pathLock);
+        path = spectrumPath;
+    }
+
+    g.setColour(juce::Colours::lime);
+    g.strokePath(path, juce::PathStrokeType(1.5f));
+}
+
+void SpectrumAnalyzer::resized()
+{
+    width = getWidth();
+    height = getHeight();
+    drawBackground();
+}
+
+void SpectrumAnalyzer::timerCallback()
+{
+    // Only repaint when the worker pool actually has something new.
+    if (hasNewFrame.exchange(false))
+        repaint();
+}
+
+void SpectrumAnalyzer::analyse(const WorkerPool::Task& t)
+{
+    // Half a frame of new samples is enough to move the analysis along.
+    while (! t.isCancelled() && source.getNumReady() >= hopSize)
+    {
+        source.pull(incoming.data(), hopSize);
+
+        // Slide the history along and put the new samples on the end.
+        std::memmove(history.data(), history.data() + hopSize, sizeof(float) * (size_t)(fftSize - hopSize));
+        std::memcpy(history.data() + (fftSize - hopSize), incoming.data(), sizeof(float) * (size_t)hopSize);
+
+        analyseFrame();
+        buildPath();
+        hasNewFrame = true;
+    }
+}
+
+void SpectrumAnalyzer::analyseFrame()
+{
+    std::fill(fftData.begin(), fftData.end(), 0.0f);
+    std::copy(history.begin(), history.end(), fftData.begin());
+
+    window.multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // A Hann window loses half the amplitude, so a full scale sine reads close to 0dB.
+    const auto scale = 4.0f / (float)fftSize;
+
+    for (size_t bin = 0; bin < smoothedLevels.size(); ++bin)
+    {
+        const auto level = juce::Decibels::gainToDecibels(fftData[bin] * scale, minimumDecibels);
+        smoothedLevels[bin] = smoothing * smoothedLevels[bin] + (1.0f - smoothing) * level;
+    }
+}
+
+void SpectrumAnalyzer::buildPath()
+{
+    const auto w = (float)width.load();
+    const auto h = (float)height.load();
+
+    if (w <= 0.0f || h <= 0.0f)
+        return;
+
+    const auto nyquist = (float)source.getSampleRate() * 0.5f;
+    const auto binWidth = nyquist / (float)smoothedLevels.size();
+
+    juce::Path path;
+    path.preallocateSpace((int)w * 3);
+
+    // One point per pixel, taken from the loudest bin that lands on it so narrow peaks don't vanish.
+    size_t bin = 1;
+
+    for (int x = 0; x < (int)w; ++x)
+    {
+        const auto frequencyEnd = juce::mapToLog10((float)(x + 1) / w, 20.0f, 20000.0f);
+        auto level = minimumDecibels;
+
+        while (bin < smoothedLevels.size() && (float)bin * binWidth <= frequencyEnd)
+            level = juce::jmax(level, smoothedLevels[bin++]);
+
+        const auto y = juce::jmap(level, minimumDecibels, maximumDecibels, h, 0.0f);
+
+        if (x == 0)
+            path.startNewSubPath(0.0f, y);
+        else
+            path.lineTo((float)x, y);
+    }
+
+    const juce::ScopedLock lock(pathLock);
+    spectrumPath.swapWithPath(path);
+}
+
+void SpectrumAnalyzer::drawBackground()
+{
+    if (getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    background = juce::Image(juce::Image::RGB, getWidth(), getHeight(), true);
+    juce::Graphics g(background);
+
+    g.fillAll(juce::Colours::black);
+    g.setColour(juce::Colours::darkgrey);
+
+    // A line every octave-ish and every 12dB.
+    for (auto frequency : { 50.0f, 100.0f, 200.0f, 500.0f, 1000.0f, 2000.0f, 5000.0f, 10000.0f })
+    {
+        const auto x = juce::mapFromLog10(frequency, 20.0f, 20000.0f) * (float)getWidth();
+        g.drawVerticalLine((int)x, 0.0f, (float)getHeight());
+    }
+
+    for (auto decibels = maximumDecibels - 6.0f; decibels > minimumDecibels; decibels -= 12.0f)
+    {
+        const auto y = juce::jmap(decibels, minimumDecibels, maximumDecibels, (float)getHeight(), 0.0f);
+        g.drawHorizontalLine((int)y, 0.0f, (float)getWidth());
+    }
+}
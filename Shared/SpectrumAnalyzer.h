@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 18 Oct 2026 4:40:03pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "WorkerPool.h"
+#include "ReBlocker.h"
+
+// The audio side of the analyzer. The processor pushes its output in here and the
+// only cost on the audio thread is a copy into a lock-free single producer, single consumer FIFO.
+// The samples go through a fixed latency ReBlocker on the way, so the FIFO only ever holds whole hops.
+class AnalyzerSource
+{
+public:
+    // The analyzer moves along half an FFT frame at a time, and gets the signal in exactly these.
+    static constexpr int hopSize{ 1024 };
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+
+    // Audio thread only. Copies the first channel, anything that doesn't fit is dropped.
+    void push(const juce::AudioBuffer<float>& buffer);
+
+    // Worker pool only. Reads up to numSamples and returns how many were read.
+    int pull(float* destination, int numSamples);
+
+    int getNumReady() const { return fifo.getNumReady(); }
+
+    // How far the analyzer's input runs behind the audio, the hop the ReBlocker holds on to. The audio itself
+    // isn't delayed, so this is nothing the host needs to know about.
+    int getLatencySamples() const { return reBlocker.getLatencySamples(); }
+    double getSampleRate() const { return sampleRate.load(); }
+
+    size_t getFootprintBytes() const { return (size_t)fifoSize * sizeof(float); }
+
+private:
+    // Writes one whole hop, or drops it if the analyzer hasn't kept up.
+    void write(const float* hop);
+
+    // A whole number of hops, so every hop lands in one piece.
+    static constexpr int fifoSize{ 32 * hopSize };
+
+    ReBlocker reBlocker;
+
+    // The ReBlocker works in place, so the first channel is copied in here first.
+    juce::AudioBuffer<float> scratch;
+
+    juce::AbstractFifo fifo{ fifoSize };
+    juce::HeapBlock<float> samples{ (size_t)fifoSize, true };
+    std::atomic<double> sampleRate{ 44100.0 };
+};
+
+// Shows the spectrum of an AnalyzerSource. The FFT, windowing and smoothing all run on the shared
+// worker pool, which also builds the path, so painting only draws what is already there.
+class SpectrumAnalyzer : public juce::Component,
+                         private juce::Timer
+{
+public:
+    explicit SpectrumAnalyzer(AnalyzerSource& source);
+    ~SpectrumAnalyzer() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void timerCallback() override;
+
+    // Runs on the worker pool every 10ms, and goes through however many frames have built up since last time.
+    void analyse(const WorkerPool::Task& task);
+
+    // Windows the latest fftSize samples, transforms them and folds the result into the smoothed spectrum.
+    void analyseFrame();
+
+    // Rebuilds the path from the smoothed spectrum, on the worker pool.
+    void buildPath();
+
+    // Draws the frequency and level grid once into an image.
+    void drawBackground();
+
+    AnalyzerSource& source;
+
+    static constexpr int fftOrder{ 11 };
+    static constexpr int fftSize{ 1 << fftOrder };
+    static constexpr int hopSize{ AnalyzerSource::hopSize };
+    static_assert(fftSize == 2 * hopSize, "Each frame is half new samples");
+
+    juce::dsp::FFT fft{ fftOrder };
+    juce::dsp::WindowingFunction<float> window{ (size_t)fftSize, juce::dsp::WindowingFunction<float>::hann };
+
+    // The most recent fftSize samples, and room for the transform to work in.
+    std::vector<float> history = std::vector<float>((size_t)fftSize, 0.0f);
+    std::vector<float> incoming = std::vector<float>((size_t)hopSize, 0.0f);
+    std::vector<float> fftData = std::vector<float>((size_t)fftSize * 2, 0.0f);
+
+    // Decibels per bin after smoothing.
+    std::vector<float> smoothedLevels = std::vector<float>((size_t)fftSize / 2, -100.0f);
+
+    // Written on the worker pool, copied by the message thread while holding the lock.
+    juce::Path spectrumPath;
+    juce::CriticalSection pathLock;
+    std::atomic<bool> hasNewFrame{ false };
+
+    // The size of the component, the worker pool needs it to build the path.
+    std::atomic<int> width{ 0 }, height{ 0 };
+
+    juce::Image background;
+
+    juce::SharedResourcePointer<WorkerPool> pool;
+    WorkerPool::TaskPtr task;
+
+    static constexpr float minimumDecibels{ -100.0f };
+    static constexpr float maximumDecibels{ 6.0f };
+    static constexpr float smoothing{ 0.7f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
+};
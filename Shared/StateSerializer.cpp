@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    StateSerializer.cpp
+    Created: 18 Oct 2026 11:47:52am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "StateSerializer.h"
+
+void StateSerializer::save(const juce::AudioProcessor& processor, juce::MemoryBlock& destData)
+{
+    std::vector<float> values;
+
+    for (auto* parameter : processor.getParameters())
+        values.push_back(parameter->getValue());
+
+    encode(processor, values, destData);
+}
+
+bool StateSerializer::load(juce::AudioProcessor& processor, const void* data, int sizeInBytes)
+{
+    std::vector<float> values;
+
+    if (! decode(processor, data, sizeInBytes, values))
+        return false;
+
+    apply(processor, values);
+    return true;
+}
+
+void StateSerializer::encode(const juce::AudioProcessor& processor, const std::vector<float>& values, juce::MemoryBlock& destData)
+{
+    const auto& parameters = processor.getParameters();
+    jassert((int)values.size() == parameters.size());
+
+    juce::MemoryOutputStream stream(destData, false);
+
+    // The header is the magic number, the version and how many parameters follow.
+    stream.writeInt((int)magicNumber);
+    stream.writeShort((short)currentVersion);
+    stream.writeShort((short)parameters.size());
+
+    // Then each parameter is its id followed by its normalised value.
+    for (int i = 0; i < parameters.size(); ++i)
+    {
+        auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameters.getUnchecked(i));
+        jassert(withID != nullptr);
+
+        const auto* id = withID != nullptr ? withID->paramID.toRawUTF8() : "";
+        const auto idLength = juce::jmin((int)std::strlen(id), 255);
+
+        stream.writeByte((char)idLength);
+        stream.write(id, (size_t)idLength);
+        stream.writeFloat((size_t)i < values.size() ? values[(size_t)i] : parameters.getUnchecked(i)->getValue());
+    }
+}
+
+bool StateSerializer::decode(const juce::AudioProcessor& processor, const void* data, int sizeInBytes, std::vector<float>& values)
+{
+    if (data == nullptr || sizeInBytes < 4)
+        return false;
+
+    values.assign((size_t)processor.getParameters().size(), std::numeric_limits<float>::quiet_NaN());
+
+    // Anything without the magic number was saved before the binary format existed.
+    if ((juce::uint32)juce::ByteOrder::littleEndianInt(data) == magicNumber)
+        return decodeBinary(processor, data, sizeInBytes, values);
+
+    return decodeXml(processor, data, sizeInBytes, values);
+}
+
+void StateSerializer::apply(juce::AudioProcessor& processor, const std::vector<float>& values)
+{
+    const auto& parameters = processor.getParameters();
+
+    for (int i = 0; i < parameters.size() && (size_t)i < values.size(); ++i)
+    {
+        const auto value = values[(size_t)i];
+
+        // Only parameters that actually change are touched, so the host isn't flooded with notifications.
+        if (! std::isnan(value) && value != parameters.getUnchecked(i)->getValue())
+            parameters.getUnchecked(i)->setValueNotifyingHost(value);
+    }
+}
+
+void StateSerializer::applyWithoutNotifying(juce::AudioProcessor& processor, const std::vector<float>& values,
+                                            const std::vector<std::atomic<float>*>& plainValues)
+{
+    const auto& parameters = processor.getParameters();
+
+    for (int i = 0; i < parameters.size() && (size_t)i < values.size(); ++i)
+    {
+        const auto value = values[(size_t)i];
+
+        if (std::isnan(value))
+            continue;
+
+        auto* parameter = parameters.getUnchecked(i);
+        parameter->setValue(value);
+
+        // Only ever set for a RangedAudioParameter, see PresetBank's constructor.
+        if ((size_t)i < plainValues.size() && plainValues[(size_t)i] != nullptr)
+            plainValues[(size_t)i]->store(static_cast<juce::RangedAudioParameter*>(parameter)->convertFrom0to1(value));
+    }
+}
+
+void StateSerializer::notify(juce::AudioProcessor& processor, const std::vector<float>& values)
+{
+    const auto& parameters = processor.getParameters();
+
+    for (int i = 0; i < parameters.size() && (size_t)i < values.size(); ++i)
+    {
+        // The value may have moved on since, so everyone is told what it is now rather than what the preset said.
+        if (! std::isnan(values[(size_t)i]))
+            parameters.getUnchecked(i)->sendValueChangedMessageToListeners(parameters.getUnchecked(i)->getValue());
+    }
+}
+
+bool StateSerializer::decodeBinary(const juce::AudioProcessor& processor, const void* data, int sizeInBytes, std::vector<float>& values)
+{
+    juce::MemoryInputStream stream(data, (size_t)sizeInBytes, false);
+
+    stream.readInt();
+    const auto version = (int)(juce::uint16)stream.readShort();
+    const auto numStored = (int)(juce::uint16)stream.readShort();
+
+    // A state from a newer build could mean anything, so leave the parameters alone.
+    if (version > currentVersion)
+        return false;
+
+    // Ids are not copied, they point straight into the data that is being loaded.
+    std::vector<StoredParameter> stored;
+    stored.reserve((size_t)numStored);
+
+    const auto* bytes = static_cast<const char*>(data);
+
+    for (int i = 0; i < numStored; ++i)
+    {
+        StoredParameter parameter;
+        parameter.idLength = (int)(juce::uint8)stream.readByte();
+        parameter.id = bytes + stream.getPosition();
+
+        if (stream.getNumBytesRemaining() < parameter.idLength + (int)sizeof(float))
+            return false;
+
+        stream.skipNextBytes(parameter.idLength);
+        parameter.value = stream.readFloat();
+        stored.push_back(parameter);
+    }
+
+    migrate(stored, version);
+
+    const auto& parameters = processor.getParameters();
+
+    for (size_t i = 0; i < stored.size(); ++i)
+    {
+        const auto index = findParameter(parameters, (int)i, stored[i].id, stored[i].idLength);
+
+        if (index >= 0)
+            values[(size_t)index] = juce::jlimit(0.0f, 1.0f, stored[i].value);
+    }
+
+    return true;
+}
+
+bool StateSerializer::decodeXml(const juce::AudioProcessor& processor, const void* data, int sizeInBytes, std::vector<float>& values)
+{
+    // A unique ptr that gets the Xml Data from the Binary
+    std::unique_ptr<juce::XmlElement> xmlState(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+
+    if (xmlState == nullptr)
+        return false;
+
+    const auto& parameters = processor.getParameters();
+    int expectedIndex = 0;
+
+    // The value tree state saved each parameter as a PARAM element holding its real, not normalised, value.
+    for (auto* element : xmlState->getChildWithTagNameIterator("PARAM"))
+    {
+        const auto id = element->getStringAttribute("id");
+        const auto index = findParameter(parameters, expectedIndex++, id.toRawUTF8(), (int)id.getNumBytesAsUTF8());
+
+        if (auto* parameter = dynamic_cast<juce::RangedAudioParameter*>(parameters[index]))
+            values[(size_t)index] = parameter->convertTo0to1((float)element->getDoubleAttribute("value"));
+    }
+
+    return true;
+}
+
+void StateSerializer::migrate(std::vector<StoredParameter>& parameters, int fromVersion)
+{
+    // Version 1 is the first binary layout so nothing needs to change yet.
+    // Each new version adds an "if (fromVersion < n)" step here that renames, rescales or drops parameters.
+    juce::ignoreUnused(parameters, fromVersion);
+}
+
+int StateSerializer::findParameter(const juce::Array<juce::AudioProcessorParameter*>& parameters, int expectedIndex, const char* id, int idLength)
+{
+    auto matches = [id, idLength](juce::AudioProcessorParameter* parameter)
+    {
+        auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter);
+
+        return withID != nullptr
+            && (int)withID->paramID.getNumBytesAsUTF8() == idLength
+            && std::memcmp(withID->paramID.toRawUTF8(), id, (size_t)idLength) == 0;
+    };
+
+    if (juce::isPositiveAndBelow(expectedIndex, parameters.size()) && matches(parameters.getUnchecked(expectedIndex)))
+        return expectedIndex;
+
+    for (int i = 0; i < parameters.size(); ++i)
+        if (matches(parameters.getUnchecked(i)))
+            return i;
+
+    return -1;
+}
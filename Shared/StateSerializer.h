@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    StateSerializer.h
+    Created: 18 Oct 2026 11:47:52am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Saves and restores the parameters of a processor as a small versioned binary blob.
+// Older sessions that were saved as XML through copyXmlToBinary can still be loaded.
+class StateSerializer
+{
+public:
+    // Bump this whenever the layout of the binary state changes, and add a step to migrate().
+    static constexpr juce::uint16 currentVersion{ 1 };
+
+    // Marks the start of every binary state, "ALPS" when read as text.
+    static constexpr juce::uint32 magicNumber{ 0x53504c41 };
+
+    static void save(const juce::AudioProcessor& processor, juce::MemoryBlock& destData);
+    static bool load(juce::AudioProcessor& processor, const void* data, int sizeInBytes);
+
+    // Writes the given normalised values, one per parameter of the processor, in the binary format.
+    static void encode(const juce::AudioProcessor& processor, const std::vector<float>& values, juce::MemoryBlock& destData);
+
+    // Reads a binary or XML state into one normalised value per parameter, parameters it does not mention are left as NaN.
+    static bool decode(const juce::AudioProcessor& processor, const void* data, int sizeInBytes, std::vector<float>& values);
+
+    // Sets every parameter that has a value and tells the host. That takes the host's locks, so it is for the message thread.
+    static void apply(juce::AudioProcessor& processor, const std::vector<float>& values);
+
+    // Only sets the values, for the audio thread. plainValues, if it isn't empty, holds the value tree's atomic for
+    // each parameter, which gets the plain value so the processor reads it straight away. Nothing listening to the
+    // parameters hears about it until notify() is called with the same values.
+    static void applyWithoutNotifying(juce::AudioProcessor& processor, const std::vector<float>& values,
+                                      const std::vector<std::atomic<float>*>& plainValues);
+
+    // Tells the host and the listeners about every parameter that has a value, at whatever it is set to now. Message thread only.
+    static void notify(juce::AudioProcessor& processor, const std::vector<float>& values);
+
+    // A single parameter as it was stored, the id points into the data being loaded.
+    struct StoredParameter
+    {
+        const char* id{ nullptr };
+        int idLength{ 0 };
+        float value{ 0.0f };
+    };
+
+private:
+    static bool decodeBinary(const juce::AudioProcessor& processor, const void* data, int sizeInBytes, std::vector<float>& values);
+    static bool decodeXml(const juce::AudioProcessor& processor, const void* data, int sizeInBytes, std::vector<float>& values);
+
+    // Brings parameters saved by an older version up to date before they are applied.
+    static void migrate(std::vector<StoredParameter>& parameters, int fromVersion);
+
+    // Finds the index of the parameter with the given id, checking the expected index first since the order hardly ever changes.
+    static int findParameter(const juce::Array<juce::AudioProcessorParameter*>& parameters, int expectedIndex, const char* id, int idLength);
+};
@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    StereoScope.cpp
+    Created: 19 Oct 2026 2:12:47am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "StereoScope.h"
+
+void StereoScopeSource::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    juce::ignoreUnused(samplesPerBlock);
+    hostSampleRate = sampleRate;
+    decimation = juce::jmax(1, juce::roundToInt(sampleRate / pointsPerSecond));
+    reset();
+}
+
+void StereoScopeSource::reset()
+{
+    decimationPhase = 0;
+    blockLR = blockLL = blockRR = 0.0;
+    runningLR = runningLL = runningRR = 0.0;
+    correlation = 1.0f;
+}
+
+void StereoScopeSource::push(const float* left, const float* right, int numSamples)
+{
+    accumulate(left, right, numSamples, blockLL, blockRR, blockLR);
+    pushPoints(left, right, numSamples);
+}
+
+void StereoScopeSource::pushPoints(const float* left, const float* right, int numSamples)
+{
+    if (numSamples <= decimationPhase)
+    {
+        decimationPhase -= numSamples;
+        return;
+    }
+
+    // The phase carries over, so the points stay evenly spaced across blocks of any size.
+    auto sample = decimationPhase;
+    const auto numPoints = (numSamples - sample - 1) / decimation + 1;
+    decimationPhase = sample + numPoints * decimation - numSamples;
+
+    const auto scope = fifo.write(juce::jmin(numPoints, fifo.getFreeSpace()));
+
+    auto write = [&](int start, int count)
+    {
+        for (int i = 0; i < count; ++i, sample += decimation)
+            points[start + i] = { left[sample], right[sample] };
+    };
+
+    write(scope.startIndex1, scope.blockSize1);
+    write(scope.startIndex2, scope.blockSize2);
+}
+
+void StereoScopeSource::addSums(double sumLR, double sumLL, double sumRR)
+{
+    blockLR += sumLR;
+    blockLL += sumLL;
+    blockRR += sumRR;
+}
+
+void StereoScopeSource::endBlock(int numSamples)
+{
+    // The running sums forget over meterSeconds, which gives the meter its ballistics without a sqrt per sample.
+    const auto blockSeconds = (double)juce::jmax(1, numSamples) / hostSampleRate;
+    const auto decay = std::exp(-blockSeconds / meterSeconds);
+
+    runningLR = runningLR * decay + blockLR;
+    runningLL = runningLL * decay + blockLL;
+    runningRR = runningRR * decay + blockRR;
+    blockLR = blockLL = blockRR = 0.0;
+
+    // Silence can't cancel out in mono, so once everything has died away it reads the same as a mono signal.
+    const auto energy = std::sqrt(runningLL * runningRR);
+    correlation = energy > 1.0e-12 ? (float)juce::jlimit(-1.0, 1.0, runningLR / energy) : 1.0f;
+}
+
+int StereoScopeSource::pull(juce::Point<float>* destination, int maxPoints)
+{
+    const auto scope = fifo.read(juce::jmin(maxPoints, fifo.getNumReady()));
+
+    if (scope.blockSize1 > 0)
+        std::copy(points + scope.startIndex1, points + scope.startIndex1 + scope.blockSize1, destination);
+
+    if (scope.blockSize2 > 0)
+        std::copy(points + scope.startIndex2, points + scope.startIndex2 + scope.blockSize2, destination + scope.blockSize1);
+
+    return scope.blockSize1 + scope.blockSize2;
+}
+
+void StereoScopeSource::accumulate(const float* a, const float* b, int numSamples, double& sumAA, double& sumBB, double& sumAB)
+{
+    constexpr int lanes = 8;
+    float aa[lanes]{}, bb[lanes]{}, ab[lanes]{};
+
+    int i = 0;
+
+    for (; i + lanes <= numSamples; i += lanes)
+    {
+        for (int k = 0; k < lanes; ++k)
+        {
+            aa[k] += a[i + k] * a[i + k];
+            bb[k] += b[i + k] * b[i + k];
+            ab[k] += a[i + k] * b[i + k];
+        }
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        aa[0] += a[i] * a[i];
+        bb[0] += b[i] * b[i];
+        ab[0] += a[i] * b[i];
+    }
+
+    for (int k = 0; k < lanes; ++k)
+    {
+        sumAA += aa[k];
+        sumBB += bb[k];
+        sumAB += ab[k];
+    }
+}
+
+//==============================================================================
+StereoScope::StereoScope(StereoScopeSource& s)
+    : source(s)
+{
+    setOpaque(true);
+    startTimerHz(framesPerSecond);
+}
+
+StereoScope::~StereoScope()
+{
+    stopTimer();
+}
+
+void StereoScope::paint(juce::Graphics& g)
+{
+    g.drawImageAt(background, 0, 0);
+
+    g.setColour(juce::Colours::lime.withAlpha(0.7f));
+
+    for (int i = 0; i < numVertices; ++i)
+        g.fillRect(vertices[(size_t)i].x, vertices[(size_t)i].y, 1.5f, 1.5f);
+
+    // The bar grows out from the middle, red when the output would lose something in mono.
+    const auto centre = meterArea.getCentreX();
+    const auto x = juce::jmap(shownCorrelation, -1.0f, 1.0f, meterArea.getX(), meterArea.getRight());
+
+    g.setColour(shownCorrelation < 0.0f ? juce::Colours::red : juce::Colours::lime);
+    g.fillRect(juce::Rectangle<float>(juce::jmin(centre, x), meterArea.getY() + 2.0f,
+                                      std::abs(x - centre), meterArea.getHeight() - 4.0f));
+}
+
+void StereoScope::resized()
+{
+    auto bounds = getLocalBounds().toFloat();
+    meterArea = bounds.removeFromBottom(16.0f).reduced(4.0f, 0.0f);
+
+    const auto side = juce::jmin(bounds.getWidth(), bounds.getHeight()) - 8.0f;
+    scopeArea = bounds.withSizeKeepingCentre(side, side);
+
+    numVertices = 0;
+    drawBackground();
+}
+
+void StereoScope::timerCallback()
+{
+    // Everything that came in since the last frame, straight into the vertex buffer.
+    const auto numRead = source.pull(vertices.data(), (int)vertices.size());
+    const auto correlation = source.getCorrelation();
+
+    if (numRead == 0 && numVertices == 0 && correlation == shownCorrelation)
+        return;
+
+    // Turned 45 degrees so mono is straight up, left only leans to the left and out of phase lies flat.
+    const auto centre = scopeArea.getCentre();
+    const auto radius = scopeArea.getWidth() * 0.5f;
+    const auto scale = radius * juce::MathConstants<float>::sqrt2 * 0.5f;
+
+    for (int i = 0; i < numRead; ++i)
+    {
+        auto& v = vertices[(size_t)i];
+        const auto x = juce::jlimit(-radius, radius, (v.y - v.x) * scale);
+        const auto y = juce::jlimit(-radius, radius, (v.x + v.y) * scale);
+        v = { centre.x + x, centre.y - y };
+    }
+
+    numVertices = numRead;
+    shownCorrelation = correlation;
+    repaint();
+}
+
+void StereoScope::drawBackground()
+{
+    if (getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    background = juce::Image(juce::Image::RGB, getWidth(), getHeight(), true);
+    juce::Graphics g(background);
+
+    g.fillAll(juce::Colours::black);
+    g.setColour(juce::Colours::darkgrey);
+    g.drawEllipse(scopeArea, 1.0f);
+
+    // M straight up, S across, and L and R on the diagonals.
+    const auto centre = scopeArea.getCentre();
+    const auto radius = scopeArea.getWidth() * 0.5f;
+    const auto diagonal = radius * juce::MathConstants<float>::sqrt2 * 0.5f;
+
+    g.drawLine(centre.x, scopeArea.getY(), centre.x, scopeArea.getBottom());
+    g.drawLine(scopeArea.getX(), centre.y, scopeArea.getRight(), centre.y);
+    g.drawLine(centre.x - diagonal, centre.y - diagonal, centre.x + diagonal, centre.y + diagonal);
+    g.drawLine(centre.x - diagonal, centre.y + diagonal, centre.x + diagonal, centre.y - diagonal);
+
+    g.setFont(11.0f);
+    g.drawText("L", juce::Rectangle<float>(centre.x - diagonal - 14.0f, centre.y - diagonal - 14.0f, 12.0f, 12.0f), juce::Justification::centred);
+    g.drawText("R", juce::Rectangle<float>(centre.x + diagonal + 2.0f, centre.y - diagonal - 14.0f, 12.0f, 12.0f), juce::Justification::centred);
+
+    // The meter scale, -1 to 1 with a mark in the middle.
+    g.drawRect(meterArea, 1.0f);
+    g.drawVerticalLine((int)meterArea.getCentreX(), meterArea.getY(), meterArea.getBottom());
+    g.drawText("-1", meterArea, juce::Justification::centredLeft);
+    g.drawText("+1", meterArea, juce::Justification::centredRight);
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    StereoScope.h
+    Created: 19 Oct 2026 2:12:47am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// The audio side of the correlation meter and goniometer. The processor adds up L * R, L * L and R * R as it goes
+// over the output, and every few samples a left and right pair goes into a lock-free single producer, single consumer
+// FIFO as a point for the goniometer. The meter itself is worked out once a block from the running sums.
+class StereoScopeSource
+{
+public:
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+    void reset();
+
+    // Audio thread only. Adds up the sums for the meter and takes the points, for processors that haven't got the sums already.
+    void push(const float* left, const float* right, int numSamples);
+
+    // Audio thread only. Takes every decimation'th pair as a point, anything that doesn't fit is dropped.
+    void pushPoints(const float* left, const float* right, int numSamples);
+
+    // Audio thread only. For processors that work the sums out in their own pass over the samples.
+    void addSums(double sumLR, double sumLL, double sumRR);
+
+    // Audio thread only. Folds the sums from this block into the meter, numSamples is the length of the whole block.
+    void endBlock(int numSamples);
+
+    // Message thread only. Reads up to maxPoints, with the left in x and the right in y, and returns how many were read.
+    int pull(juce::Point<float>* destination, int maxPoints);
+
+    // From -1 when the channels would cancel in mono, through 0 for unrelated, to 1 for mono.
+    float getCorrelation() const { return correlation.load(); }
+
+    size_t getFootprintBytes() const { return (size_t)fifoSize * sizeof(juce::Point<float>); }
+
+    // The most points the FIFO can hold, which is also as many as one frame of the goniometer can show.
+    static constexpr int fifoSize{ 8192 };
+
+    // Adds up a * a, b * b and a * b over separate lanes so the compiler can vectorize it without reordering a sum.
+    static void accumulate(const float* a, const float* b, int numSamples, double& sumAA, double& sumBB, double& sumAB);
+
+private:
+    juce::AbstractFifo fifo{ fifoSize };
+    juce::HeapBlock<juce::Point<float>> points{ (size_t)fifoSize, true };
+
+    // Roughly how many points a second go to the goniometer, whatever the sample rate.
+    static constexpr double pointsPerSecond{ 6000.0 };
+
+    int decimation{ 8 };
+    int decimationPhase{ 0 };
+
+    // This block's sums, then the running sums that decay away over meterSeconds.
+    double blockLR{ 0.0 }, blockLL{ 0.0 }, blockRR{ 0.0 };
+    double runningLR{ 0.0 }, runningLL{ 0.0 }, runningRR{ 0.0 };
+
+    static constexpr double meterSeconds{ 0.3 };
+
+    double hostSampleRate{ 44100.0 };
+    std::atomic<float> correlation{ 1.0f };
+};
+
+// Shows a StereoScopeSource as a goniometer with the correlation meter along the bottom. The points are pulled into
+// a vertex buffer that was allocated up front, once per frame, so painting never allocates.
+class StereoScope : public juce::Component,
+                    private juce::Timer
+{
+public:
+    explicit StereoScope(StereoScopeSource& source);
+    ~StereoScope() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void timerCallback() override;
+
+    // Draws the circle, the L, R, M and S axes and the meter scale once into an image.
+    void drawBackground();
+
+    StereoScopeSource& source;
+
+    // The points from the last frame, in screen coordinates.
+    std::vector<juce::Point<float>> vertices = std::vector<juce::Point<float>>((size_t)StereoScopeSource::fifoSize);
+    int numVertices{ 0 };
+
+    float shownCorrelation{ 1.0f };
+
+    juce::Rectangle<float> scopeArea;
+    juce::Rectangle<float> meterArea;
+
+    juce::Image background;
+
+    static constexpr int framesPerSecond{ 30 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StereoScope)
+};
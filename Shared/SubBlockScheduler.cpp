@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    SubBlockScheduler.cpp
+    Created: 18 Oct 2026 11:02:15am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "SubBlockScheduler.h"
+
+SubBlockScheduler::~SubBlockScheduler()
+{
+    cancelPendingUpdate();
+}
+
+void SubBlockScheduler::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    // Keep the minimum segment at about a third of a millisecond, whatever the sample rate.
+    minimumSubBlockSize = juce::jlimit(1, juce::jmax(1, samplesPerBlock), (int)(sampleRate / 3000.0));
+    maximumSubBlockSize = juce::jmax(maximumSubBlockSize, minimumSubBlockSize);
+    preparedBlockSize = juce::jmax(1, samplesPerBlock);
+}
+
+void SubBlockScheduler::setMinimumSubBlockSize(int newMinimumSize)
+{
+    minimumSubBlockSize = juce::jmax(1, newMinimumSize);
+    maximumSubBlockSize = juce::jmax(maximumSubBlockSize, minimumSubBlockSize);
+}
+
+void SubBlockScheduler::setMaximumSubBlockSize(int newMaximumSize)
+{
+    maximumSubBlockSize = juce::jmax(1, newMaximumSize);
+    minimumSubBlockSize = juce::jmin(minimumSubBlockSize, maximumSubBlockSize);
+}
+
+void SubBlockScheduler::mapControllers(const juce::Array<juce::AudioProcessorParameter*>& parameters, int firstController,
+                                       juce::AudioProcessorValueTreeState* state)
+{
+    controllerParameters.fill(nullptr);
+    controllerValues.fill(nullptr);
+
+    // Bank select, the sustain pedal and the rest would fight with the host and other gear, so they are skipped.
+    auto controller = firstController;
+
+    for (int i = 0; i < parameters.size(); ++i, ++controller)
+    {
+        while (controller < (int)controllerParameters.size() && ! isUndefinedController(controller))
+            ++controller;
+
+        if (controller >= (int)controllerParameters.size())
+            break;
+
+        controllerParameters[(size_t)controller] = parameters[i];
+
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameters[i]); ranged != nullptr && state != nullptr)
+            controllerValues[(size_t)controller] = state->getRawParameterValue(ranged->paramID);
+    }
+}
+
+bool SubBlockScheduler::isUndefinedController(int controller)
+{
+    return controller == 3 || controller == 9 || controller == 14 || controller == 15
+        || (controller >= 20 && controller <= 31)
+        || (controller >= 85 && controller <= 90)
+        || (controller >= 102 && controller <= 119);
+}
+
+void SubBlockScheduler::handleEvent(const juce::MidiMessage& message)
+{
+    if (! message.isController())
+        return;
+
+    const auto controller = (size_t)message.getControllerNumber();
+    auto* parameter = controllerParameters[controller];
+
+    if (parameter == nullptr)
+        return;
+
+    // Controllers go from 0 to 127 which is spread over the whole normalised range of the parameter.
+    const auto value = (float)message.getControllerValue() / 127.0f;
+    parameter->setValue(value);
+
+    // The value tree only picks up a change when it is told about one, so its copy is set here as well
+    // for the rest of the block to read.
+    if (auto* plainValue = controllerValues[controller])
+        plainValue->store(static_cast<juce::RangedAudioParameter*>(parameter)->convertFrom0to1(value));
+
+    needsNotifying[controller] = true;
+    triggerAsyncUpdate();
+}
+
+void SubBlockScheduler::handleAsyncUpdate()
+{
+    for (size_t controller = 0; controller < controllerParameters.size(); ++controller)
+    {
+        auto* parameter = controllerParameters[controller];
+
+        // Whatever the value is by now, which may be a later controller message than the one that set the flag.
+        if (parameter != nullptr && needsNotifying[controller].exchange(false))
+            parameter->sendValueChangedMessageToListeners(parameter->getValue());
+    }
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    SubBlockScheduler.h
+    Created: 18 Oct 2026 11:02:15am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Splits a block up at the sample positions of its MIDI events so that anything an event changes
+// takes effect on the right sample, instead of only at the start of the next block.
+class SubBlockScheduler  : private juce::AsyncUpdater
+{
+public:
+    ~SubBlockScheduler() override;
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+
+    // Events closer together than this are applied at the start of the same segment.
+    void setMinimumSubBlockSize(int newMinimumSize);
+
+    // No segment is allowed to be longer than this, even when there are no events. Nor is one ever longer than
+    // the samplesPerBlock it was prepared with, so a host that sends bigger blocks than it said it would can't
+    // overrun anything sized from it.
+    void setMaximumSubBlockSize(int newMaximumSize);
+
+    // Assigns every parameter a MIDI controller, starting at firstController, so controller automation is sample accurate.
+    // Only controllers the MIDI spec leaves undefined are used, the ones it gives a meaning to are stepped over,
+    // and any parameters left once those run out aren't mapped.
+    // Processors that read their parameters through a value tree pass it in, so a controller can set the value
+    // the next segment reads straight away. The value tree's own listeners then miss those changes, since it
+    // already holds the value by the time it is told, so anything watching them should listen to the parameter.
+    void mapControllers(const juce::Array<juce::AudioProcessorParameter*>& parameters, int firstController,
+                        juce::AudioProcessorValueTreeState* state = nullptr);
+
+    // Calls processSegment(startSample, numSamples) for every segment of the block, in order.
+    template <typename ProcessSegment>
+    void process(int numSamples, const juce::MidiBuffer& midiMessages, ProcessSegment&& processSegment)
+    {
+        auto event = midiMessages.cbegin();
+        int segmentStart = 0;
+
+        while (segmentStart < numSamples)
+        {
+            // Every event that lands inside the minimum segment is applied before it starts.
+            const auto minimumEnd = juce::jmin(numSamples, segmentStart + minimumSubBlockSize);
+
+            for (; event != midiMessages.cend() && (*event).samplePosition < minimumEnd; ++event)
+                handleEvent((*event).getMessage());
+
+            // The segment then runs up to the next event, or as far as it is allowed to go.
+            auto segmentEnd = juce::jmin(numSamples, segmentStart + juce::jmin(maximumSubBlockSize, preparedBlockSize));
+
+            if (event != midiMessages.cend())
+                segmentEnd = juce::jmin(segmentEnd, (*event).samplePosition);
+
+            segmentEnd = juce::jmax(segmentEnd, minimumEnd);
+
+            processSegment(segmentStart, segmentEnd - segmentStart);
+            segmentStart = segmentEnd;
+        }
+
+        // Some hosts send events stamped past the end of the block, they still need to be applied.
+        for (; event != midiMessages.cend(); ++event)
+            handleEvent((*event).getMessage());
+    }
+
+private:
+    // Updates the parameter that is mapped to a controller message. This is on the audio thread, so the host
+    // and the parameter's listeners are told about it later from the message thread.
+    void handleEvent(const juce::MidiMessage& message);
+
+    // Tells the host about every parameter a controller has changed since the last time.
+    void handleAsyncUpdate() override;
+
+    // True for the controllers the MIDI spec doesn't define: 3, 9, 14, 15, 20 to 31, 85 to 90 and 102 to 119.
+    static bool isUndefinedController(int controller);
+
+    // The parameter each of the 128 controllers is mapped to, if any.
+    std::array<juce::AudioProcessorParameter*, 128> controllerParameters{};
+
+    // Where the value tree keeps each parameter's plain value, if the processor has one.
+    std::array<std::atomic<float>*, 128> controllerValues{};
+
+    // Set on the audio thread for each controller that has moved, cleared once the host has been told.
+    std::array<std::atomic<bool>, 128> needsNotifying{};
+
+    int minimumSubBlockSize{ 16 };
+    int maximumSubBlockSize{ std::numeric_limits<int>::max() };
+    int preparedBlockSize{ std::numeric_limits<int>::max() };
+};
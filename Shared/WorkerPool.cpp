@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    WorkerPool.cpp
+    Created: 18 Oct 2026 10:58:36pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool()
+{
+    // Leave a core for the audio thread, and there is never enough background work to need more than eight.
+    const auto numWorkers = juce::jlimit(1, 8, juce::SystemStats::getNumCpus() - 1);
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.add(new Worker(*this, i));
+
+    for (auto* worker : workers)
+        worker->startThread();
+}
+
+WorkerPool::~WorkerPool()
+{
+    for (auto* worker : workers)
+        worker->signalThreadShouldExit();
+
+    // Wakes one of them straight away, the rest never wait longer than 100ms at a time.
+    workAvailable.signal();
+
+    for (auto* worker : workers)
+        worker->stopThread(2000);
+
+    // Anything left in the queues never ran, so mark it as finished for whoever still holds on to it.
+    for (auto* worker : workers)
+        for (auto& queue : worker->queues)
+            for (auto& task : queue)
+                task->finished = true;
+
+    for (auto& task : repeatingTasks)
+        task->finished = true;
+}
+
+WorkerPool::TaskPtr WorkerPool::submit(std::function<void(const Task&)> work, const Priority priority)
+{
+    auto task = std::make_shared<Task>();
+    task->work = std::move(work);
+    task->priority = priority;
+
+    // Spread the jobs out round the workers, stealing evens it up from there.
+    auto* worker = workers[(int)(nextWorker++ % (unsigned int)workers.size())];
+    {
+        const juce::SpinLock::ScopedLockType lock(worker->queueLock);
+        worker->queues[(size_t)priority].push_back(task);
+    }
+
+    workAvailable.signal();
+    return task;
+}
+
+WorkerPool::TaskPtr WorkerPool::submitRepeating(std::function<void(const Task&)> work, const int intervalMilliseconds, const Priority priority)
+{
+    auto task = std::make_shared<Task>();
+    task->work = std::move(work);
+    task->priority = priority;
+    task->intervalMilliseconds = juce::jmax(1, intervalMilliseconds);
+    task->nextDue = juce::Time::getMillisecondCounter();
+
+    {
+        const juce::ScopedLock lock(repeatingLock);
+        repeatingTasks.push_back(task);
+    }
+
+    workAvailable.signal();
+    return task;
+}
+
+void WorkerPool::cancelAndWait(const TaskPtr& task)
+{
+    if (task == nullptr)
+        return;
+
+    task->cancel();
+
+    // The work checks isCancelled() as it goes, so this is never a long wait.
+    while (task->running.load())
+        juce::Thread::sleep(1);
+}
+
+WorkerPool::TaskPtr WorkerPool::findWork(int workerIndex)
+{
+    for (size_t priority = 0; priority < 3; ++priority)
+    {
+        for (int i = 0; i < workers.size(); ++i)
+        {
+            // Start with this worker's own queue, then go round the rest.
+            auto* worker = workers[(workerIndex + i) % workers.size()];
+            const juce::SpinLock::ScopedLockType lock(worker->queueLock);
+            auto& queue = worker->queues[priority];
+
+            while (! queue.empty())
+            {
+                auto task = std::move(queue.front());
+                queue.pop_front();
+
+                if (! task->isCancelled())
+                    return task;
+
+                task->finished = true;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+int WorkerPool::runRepeatingTasks()
+{
+    const auto now = juce::Time::getMillisecondCounter();
+    auto untilNext = 100;
+    TaskPtr due;
+
+    {
+        const juce::ScopedLock lock(repeatingLock);
+
+        repeatingTasks.erase(std::remove_if(repeatingTasks.begin(), repeatingTasks.end(), [](const TaskPtr& task)
+        {
+            if (task->isCancelled() && ! task->running.load())
+                task->finished = true;
+
+            return task->finished.load();
+        }), repeatingTasks.end());
+
+        for (auto& task : repeatingTasks)
+        {
+            if (task->running.load() || task->isCancelled())
+                continue;
+
+            const auto wait = (int)(task->nextDue - now);
+
+            // Claim the first one that's due, the lock stops another worker taking it as well.
+            if (wait <= 0 && due == nullptr)
+            {
+                // Marked as running before checking for a cancel, so cancelAndWait() either sees it running or it sees the cancel.
+                task->running = true;
+
+                if (task->isCancelled())
+                {
+                    task->running = false;
+                    continue;
+                }
+
+                due = task;
+                continue;
+            }
+
+            untilNext = juce::jmin(untilNext, juce::jmax(0, wait));
+        }
+    }
+
+    if (due != nullptr)
+    {
+        execute(*due);
+        due->nextDue = juce::Time::getMillisecondCounter() + (juce::uint32)due->intervalMilliseconds;
+        due->running = false;
+        return 0;
+    }
+
+    return untilNext;
+}
+
+void WorkerPool::execute(Task& task)
+{
+    task.running = true;
+
+    if (! task.isCancelled())
+        task.work(task);
+
+    // Repeating tasks only finish once they are cancelled, runRepeatingTasks() keeps them going until then.
+    if (task.intervalMilliseconds == 0)
+    {
+        task.finished = true;
+        task.running = false;
+    }
+}
+
+//==============================================================================
+WorkerPool::Worker::Worker(WorkerPool& owner, int workerIndex)
+    : juce::Thread("Worker " + juce::String(workerIndex)), pool(owner), index(workerIndex)
+{
+}
+
+void WorkerPool::Worker::run()
+{
+   #if JUCE_LINUX
+    // Core 0 is left for the host and the audio thread. Every worker may run on any of the others, so the scheduler
+    // can still move one off a core that something else is busy on, which pinning each to a single core stopped.
+    const auto numCpus = juce::SystemStats::getNumCpus();
+
+    if (numCpus > 1 && numCpus <= 32)
+    {
+        const auto allCores = numCpus == 32 ? 0xffffffffu : (1u << (juce::uint32)numCpus) - 1u;
+        juce::Thread::setCurrentThreadAffinityMask(allCores & ~1u);
+    }
+   #endif
+
+    while (! threadShouldExit())
+    {
+        if (auto task = pool.findWork(index))
+        {
+            pool.execute(*task);
+            continue;
+        }
+
+        const auto untilNext = pool.runRepeatingTasks();
+
+        if (untilNext > 0)
+            pool.workAvailable.wait(untilNext);
+    }
+}
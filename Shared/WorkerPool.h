@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    WorkerPool.h
+    Created: 18 Oct 2026 10:58:36pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// A handful of worker threads shared by every instance in the process, for the background work that would
+// otherwise get a thread per instance. Hold it through a juce::SharedResourcePointer<WorkerPool>, the first
+// one creates the pool and it shuts down cleanly when the last one goes, which is when the plugin is unloaded.
+//
+// Every worker has its own queue for each priority, and a worker that runs out of work steals from the others,
+// so a burst of jobs from one instance spreads over all of them. Repeating tasks are for anything that used to
+// be a thread polling in a loop, they run on whichever worker is free when they come due.
+class WorkerPool
+{
+public:
+    enum class Priority { high, normal, low };
+
+    // Handed back for every job so it can be cancelled, and handed to the job so it can notice.
+    class Task
+    {
+    public:
+        void cancel() { cancelled = true; }
+        bool isCancelled() const { return cancelled.load(); }
+        bool isFinished() const { return finished.load(); }
+
+    private:
+        friend class WorkerPool;
+
+        std::function<void(const Task&)> work;
+        Priority priority{ Priority::normal };
+
+        std::atomic<bool> cancelled{ false };
+        std::atomic<bool> running{ false };
+        std::atomic<bool> finished{ false };
+
+        // Only used by repeating tasks.
+        int intervalMilliseconds{ 0 };
+        juce::uint32 nextDue{ 0 };
+    };
+
+    using TaskPtr = std::shared_ptr<Task>;
+
+    WorkerPool();
+    ~WorkerPool();
+
+    // Runs the work once on the next free worker. It allocates, so it isn't for the audio thread.
+    TaskPtr submit(std::function<void(const Task&)> work, const Priority priority = Priority::normal);
+
+    // Runs the work every interval until it is cancelled.
+    TaskPtr submitRepeating(std::function<void(const Task&)> work, const int intervalMilliseconds, const Priority priority = Priority::low);
+
+    // Cancels the task and waits for it if a worker is in the middle of it. Owners call this before they
+    // destroy whatever the task works on.
+    void cancelAndWait(const TaskPtr& task);
+
+    int getNumWorkers() const { return workers.size(); }
+
+private:
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(WorkerPool& owner, int index);
+        void run() override;
+
+        // One queue per priority. The owner takes from the front, so do thieves, which keeps each queue in order.
+        std::array<std::deque<TaskPtr>, 3> queues;
+        juce::SpinLock queueLock;
+
+    private:
+        WorkerPool& pool;
+        const int index;
+    };
+
+    // The highest priority job this worker can find, its own first and then anyone else's.
+    TaskPtr findWork(int workerIndex);
+
+    // Runs whichever repeating tasks are due. Returns how long until the next one is.
+    int runRepeatingTasks();
+
+    void execute(Task& task);
+
+    juce::OwnedArray<Worker> workers;
+    std::atomic<unsigned int> nextWorker{ 0 };
+    juce::WaitableEvent workAvailable;
+
+    std::vector<TaskPtr> repeatingTasks;
+    juce::CriticalSection repeatingLock;
+
+    JUCE_DECLARE_NON_COPYABLE(WorkerPool)
+};
@@ -0,0 +1,315 @@
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+SimpleChainAudioProcessor::SimpleChainAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (BusesProperties()
+                     #if ! JucePlugin_IsMidiEffect
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                      #endif
+                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     #endif
+         // Create an instance of the AudioProcessorValueTreeState
+                       ), apvts(*this, nullptr, "PARAMETERS", createParams())
+#endif
+{
+    // Controller 20 onwards drive the parameters in the order they were added, skipping any the MIDI spec defines.
+    scheduler.mapControllers(getParameters(), firstMappedController, &apvts);
+
+    // Segments never get longer than a sub block, even when there are no MIDI events.
+    scheduler.setMaximumSubBlockSize(subBlockSize);
+}
+
+SimpleChainAudioProcessor::~SimpleChainAudioProcessor()
+{
+}
+
+//==============================================================================
+const juce::String SimpleChainAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool SimpleChainAudioProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleChainAudioProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleChainAudioProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+double SimpleChainAudioProcessor::getTailLengthSeconds() const
+{
+    return silence.getTailLengthSeconds();
+}
+
+int SimpleChainAudioProcessor::getNumPrograms()
+{
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if you're not really implementing programs.
+    return juce::jmax(1, presets.getNumPresets());
+}
+
+int SimpleChainAudioProcessor::getCurrentProgram()
+{
+    return presets.getCurrentPreset();
+}
+
+void SimpleChainAudioProcessor::setCurrentProgram (int index)
+{
+    // Only queues the preset, the audio thread switches over to it at the next block.
+    presets.selectPreset(index);
+}
+
+const juce::String SimpleChainAudioProcessor::getProgramName (int index)
+{
+    return presets.getPresetName(index);
+}
+
+void SimpleChainAudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+    presets.renamePreset(index, newName);
+}
+
+//==============================================================================
+void SimpleChainAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    // Each stage only ever sees a sub block, so none of them need more room than that.
+    const auto stageBlockSize = juce::jmin(samplesPerBlock, subBlockSize);
+    const auto numChannels = getTotalNumOutputChannels();
+
+    // All the stages share one slab. The same spec as last time fits in the one that's already there.
+    arena.prepare(DistortionData::getRequiredBytes(stageBlockSize) + ReverbData::getRequiredBytes(sampleRate, stageBlockSize, numChannels));
+
+    filter.prepareToPlay(sampleRate, stageBlockSize, numChannels);
+    distortion.prepareToPlay(sampleRate, stageBlockSize, numChannels, arena);
+    reverb.prepareToPlay(sampleRate, stageBlockSize, numChannels, arena);
+    silence.setTailLengthSeconds(filter.getTailLengthSeconds() + reverb.getTailLengthSeconds());
+    scheduler.prepareToPlay(sampleRate, samplesPerBlock);
+    presets.prepareToPlay(sampleRate);
+    silence.prepareToPlay(sampleRate, samplesPerBlock);
+}
+
+void SimpleChainAudioProcessor::releaseResources()
+{
+    // When playback stops, you can use this as an opportunity to free up any
+    // spare memory, etc.
+    presets.releaseResources();
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool SimpleChainAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    // This is the place where you check if the layout is supported.
+    // In this template code we only support mono or stereo.
+    // Some plugin hosts, such as certain GarageBand versions, will only
+    // load plugins that support stereo bus layouts.
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+void SimpleChainAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    // In case we have more outputs than inputs, this code clears any output
+    // channels that didn't contain input data, (because these aren't
+    // guaranteed to be empty - they may contain garbage).
+    // This is here to avoid people getting screaming feedback
+    // when they first compile a plugin, but obviously you don't need to keep
+    // this code if your algorithm always overwrites all the output channels.
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+
+    // Switches to a newly selected preset once the output has faded out for it.
+    presets.beginBlock();
+
+    // While nothing is coming in or ringing out, the block is left as zeros and the DSP below is skipped.
+    const auto isActive = silence.beginBlock(buffer);
+
+    if (! isActive)
+        buffer.clear();
+
+    juce::dsp::AudioBlock<float> block{ buffer };
+    block = block.getSubsetChannelBlock(0, (size_t)totalNumInputChannels);
+
+    // Instead of three passes over the whole buffer, every stage runs over a small piece while it is still in the cache.
+    // The pieces are also split at MIDI events, and the parameters are read again for each one.
+    scheduler.process(buffer.getNumSamples(), midiMessages, [&](int startSample, int numSamples)
+    {
+        // Asleep, so the segments only go by to keep the mapped controllers moving.
+        if (! isActive)
+            return;
+
+        updateParameters();
+
+        const auto& order = stageOrders[(size_t)juce::jlimit(0, (int)stageOrders.size() - 1, (int)apvts.getRawParameterValue("ORDER")->load())];
+        auto subBlock = block.getSubBlock((size_t)startSample, (size_t)numSamples);
+
+        for (auto stage : order)
+            processStage(stage, subBlock);
+    });
+
+    // Whatever order the stages are in, the filter and reverb tails add up and the distortion has none.
+    silence.setTailLengthSeconds(filter.getTailLengthSeconds() + reverb.getTailLengthSeconds());
+
+    if (silence.endBlock(buffer))
+    {
+        filter.reset();
+        distortion.reset();
+        reverb.reset();
+    }
+
+    // Fades out ahead of a queued preset, or back in after one was applied.
+    presets.endBlock(buffer);
+}
+
+void SimpleChainAudioProcessor::updateParameters()
+{
+    filter.updateParameters(apvts.getRawParameterValue("CUTOFF")->load(), apvts.getRawParameterValue("RES")->load());
+    distortion.updateParameters(apvts.getRawParameterValue("THRESHOLD")->load());
+
+    // Create a place to hold the reverb parameters
+    juce::dsp::Reverb::Parameters reverbParams;
+
+    // Get the values of all the Reverb Params.
+    reverbParams.damping = apvts.getRawParameterValue("DAMPING")->load();
+    reverbParams.dryLevel = apvts.getRawParameterValue("DRY")->load();
+    reverbParams.freezeMode = apvts.getRawParameterValue("FREEZE")->load();
+    reverbParams.roomSize = apvts.getRawParameterValue("SIZE")->load();
+    reverbParams.wetLevel = apvts.getRawParameterValue("WET")->load();
+    reverbParams.width = apvts.getRawParameterValue("WIDTH")->load();
+
+    reverb.updateParameters(reverbParams,
+                            apvts.getRawParameterValue("MIX")->load(),
+                            apvts.getRawParameterValue("DELAYLINE")->load(),
+                            apvts.getRawParameterValue("FEEDBACK")->load());
+}
+
+void SimpleChainAudioProcessor::processStage(Stage stage, juce::dsp::AudioBlock<float>& block)
+{
+    switch (stage)
+    {
+        case Stage::filter:     filter.process(block);     break;
+        case Stage::distortion: distortion.process(block); break;
+        case Stage::reverb:     reverb.process(block);     break;
+    }
+}
+
+//==============================================================================
+bool SimpleChainAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* SimpleChainAudioProcessor::createEditor()
+{
+    // Temporary front end that just works.
+    return new juce::GenericAudioProcessorEditor(this);
+    //return new SimpleChainAudioProcessorEditor (*this);
+}
+
+//==============================================================================
+void SimpleChainAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    // You should use this method to store your parameters in the memory block.
+    // You could do that either as raw data, or use the XML or ValueTree classes
+    // as intermediaries to make it easy to save and load complex data.
+
+    // Writes every parameter into a small binary blob which is much quicker to load than XML.
+    StateSerializer::save(*this, destData);
+}
+
+void SimpleChainAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    // You should use this method to restore your parameters from this memory block,
+    // whose contents will have been created by the getStateInformation() call.
+
+    // Reads the binary blob back. Sessions saved before it existed hold the apvts state as XML, which still loads.
+    StateSerializer::load(*this, data, sizeInBytes);
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout SimpleChainAudioProcessor::createParams()
+{
+    // Create an instance of the ParameterLayout
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    // Which order the three effects are run in.
+    layout.add(std::make_unique<juce::AudioParameterChoice>("ORDER", "Order",
+        juce::StringArray{ "Filter > Distortion > Reverb", "Filter > Reverb > Distortion", "Distortion > Filter > Reverb",
+                           "Distortion > Reverb > Filter", "Reverb > Filter > Distortion", "Reverb > Distortion > Filter" }, 0));
+
+    // The same parameters as SimpleFilter
+    layout.add(std::make_unique<juce::AudioParameterFloat>("CUTOFF", "Cutoff", 20.0f, 20000.0f, 500.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("RES", "Resonance", 1.0f, 10.0f, 2.5f));
+
+    // The same parameter as SimpleDistortion
+    layout.add(std::make_unique<juce::AudioParameterFloat>("THRESHOLD", "Threshold", 0.0f, 1.0f, 1.0f));
+
+    // The same parameters as SimpleReverb
+    layout.add(std::make_unique<juce::AudioParameterFloat>("DRY", "Dry", 0.0f, 1.0f, 0.75f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("WET", "Wet", 0.0f, 1.0f, 0.25f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("SIZE", "Size", 0.0, 1.0f, 0.5f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("DAMPING", "Damping", 0.0, 1.0f, 0.5f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("WIDTH", "Width", 0.0, 1.0f, 0.75f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("FREEZE", "Freeze", 0.0, 1.0f, 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("MIX", "Mix", 0.0f, 1.0f, 1.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("DELAYLINE", "Delay Line", 0.00f, ReverbData::maxDelayTimeSeconds, 0.05f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("FEEDBACK", "Feedback", 0.0f, 1.0f, 0.99f));
+
+    // Return the parameter layout.
+    return layout;
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new SimpleChainAudioProcessor();
+}
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../SimpleFilter/Source/Data/FilterData.h"
+#include "../../SimpleDistortion/Source/Data/DistortionData.h"
+#include "../../SimpleReverb/Source/Data/ReverbData.h"
+#include "../../Shared/SubBlockScheduler.h"
+#include "../../Shared/StateSerializer.h"
+#include "../../Shared/PresetBank.h"
+#include "../../Shared/SilenceDetector.h"
+
+//==============================================================================
+/**
+*/
+class SimpleChainAudioProcessor  : public juce::AudioProcessor
+                            #if JucePlugin_Enable_ARA
+                             , public juce::AudioProcessorARAExtension
+                            #endif
+{
+public:
+    //==============================================================================
+    SimpleChainAudioProcessor();
+    ~SimpleChainAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+    // Everything this instance holds for its DSP, for keeping an eye on memory with a lot of instances open.
+    size_t getDspFootprintBytes() const { return sizeof(*this) + filter.getFootprintBytes() + distortion.getFootprintBytes() + reverb.getFootprintBytes(); }
+
+private:
+    // The three effects that can be chained together.
+    enum class Stage { filter, distortion, reverb };
+
+    // Reads every parameter and hands it to the stage that uses it.
+    void updateParameters();
+
+    // Runs a single effect over a sub block.
+    void processStage(Stage stage, juce::dsp::AudioBlock<float>& block);
+
+    // Every order the three stages can be run in, in the same order as the ORDER parameter.
+    static constexpr std::array<std::array<Stage, 3>, 6> stageOrders
+    {{
+        {{ Stage::filter,     Stage::distortion, Stage::reverb     }},
+        {{ Stage::filter,     Stage::reverb,     Stage::distortion }},
+        {{ Stage::distortion, Stage::filter,     Stage::reverb     }},
+        {{ Stage::distortion, Stage::reverb,     Stage::filter     }},
+        {{ Stage::reverb,     Stage::filter,     Stage::distortion }},
+        {{ Stage::reverb,     Stage::distortion, Stage::filter     }}
+    }};
+
+    // How many samples go through every stage before moving on, small enough to stay in the L1 cache.
+    static constexpr int subBlockSize{ 64 };
+
+    // Every DSP buffer for all the stages comes out of this, it has to outlive them so it goes first.
+    DspArena arena;
+
+    FilterData filter;
+    DistortionData distortion;
+    ReverbData reverb;
+
+    // Splits each block up at its MIDI events.
+    SubBlockScheduler scheduler;
+
+    // The first MIDI controller that is mapped to a parameter. 20 to 31 are undefined in the MIDI spec, once
+    // they run out the scheduler carries on from the next undefined one, 85.
+    static constexpr int firstMappedController{ 20 };
+
+    // The ValueTreeState object
+    juce::AudioProcessorValueTreeState apvts;
+
+    // Creates a Parameter Layout for the Value Tree State
+    juce::AudioProcessorValueTreeState::ParameterLayout createParams();
+
+    // Every preset as a snapshot of parameter values, switched over without locking.
+    PresetBank presets{ *this, &apvts };
+
+    // Skips the DSP while the input and anything left ringing out are both silent.
+    SilenceDetector silence;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleChainAudioProcessor)
+};
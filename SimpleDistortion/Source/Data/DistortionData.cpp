@@ -0,0 +1,318 @@
+/*
+  ==============================================================================
+
+    DistortionData.cpp
+    Created: 18 Oct 2026 10:12:41am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "DistortionData.h"
+
+size_t DistortionData::getRequiredBytes(int samplesPerBlock)
+{
+    return DspArena::getAlignedSize((size_t)juce::jmax(1, samplesPerBlock) * Lanes::size() * sizeof(float));
+}
+
+void DistortionData::prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels, DspArena& arena)
+{
+    hostSampleRate = sampleRate;
+    preparedChannels = numChannels;
+
+    juce::dsp::ProcessSpec spec;
+    spec.maximumBlockSize = (juce::uint32)samplesPerBlock;
+    spec.sampleRate = sampleRate;
+    spec.numChannels = (juce::uint32)numChannels;
+
+    for (size_t crossover = 0; crossover < crossovers.size(); ++crossover)
+    {
+        crossovers[crossover].prepare(spec);
+        crossovers[crossover].setCutoffFrequency(crossoverFrequencies[crossover]);
+
+        for (auto& bandAllpasses : allpasses)
+        {
+            bandAllpasses[crossover].setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+            bandAllpasses[crossover].prepare(spec);
+            bandAllpasses[crossover].setCutoffFrequency(crossoverFrequencies[crossover]);
+        }
+    }
+
+    // One register's worth of lanes per sample. The arena lines everything up on a cache line, which covers the SIMD loads.
+    static_assert(DspArena::alignment % Lanes::SIMDRegisterSize == 0, "The arena has to line up with the registers");
+    maxBlockSize = juce::jmax(1, samplesPerBlock);
+    bandData = arena.allocate<float>((size_t)maxBlockSize * Lanes::size(), bandFallback);
+
+    // The lookup tables are built here so the audio thread never has to.
+    shaper.prepare();
+
+    updateLanes();
+    isPrepared = true;
+}
+
+void DistortionData::process(juce::AudioBuffer<float>& buffer)
+{
+    juce::dsp::AudioBlock<float> block{ buffer };
+    process(block);
+}
+
+void DistortionData::process(juce::dsp::AudioBlock<float>& block)
+{
+    jassert(isPrepared);
+
+    const auto kernel = selectKernel(block);
+
+    if (kernel == nullptr)
+        return;
+
+    // The scratch space only holds maxBlockSize samples, so anything longer is done a piece at a time.
+    ReBlocker::forEachChunk(block, maxBlockSize, [this, kernel](juce::dsp::AudioBlock<float>& subBlock)
+    {
+        (this->*kernel)(subBlock);
+    });
+}
+
+DistortionData::Kernel DistortionData::selectKernel(const juce::dsp::AudioBlock<float>& block) const
+{
+    const auto isFolder = shape == 0;
+
+    if (numBands > 1)
+        return isFolder ? &DistortionData::processMultiBand<true> : &DistortionData::processMultiBand<false>;
+
+    // Below the threshold the folder hands the signal straight back, so a quick look for the peak saves the whole fold.
+    if (isFolder && drives[0] == 1.0f)
+    {
+        auto peak = 0.0f;
+
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            peak = juce::jmax(peak, SimdKernels::get().findPeak(block.getChannelPointer(channel), (int)block.getNumSamples()));
+
+        if (peak <= juce::jmax(minimumThreshold, thresholds[0]))
+            return nullptr;
+    }
+
+    return isFolder ? &DistortionData::processSingleBand<true> : &DistortionData::processSingleBand<false>;
+}
+
+void DistortionData::reset()
+{
+    for (auto& crossover : crossovers)
+        crossover.reset();
+
+    for (auto& bandAllpasses : allpasses)
+        for (auto& allpass : bandAllpasses)
+            allpass.reset();
+}
+
+void DistortionData::updateParameters(const float newThreshold)
+{
+    numBands = 1;
+    thresholds[0] = newThreshold;
+    drives[0] = 1.0f;
+
+    updateLanes();
+}
+
+void DistortionData::updateParameters(const int newNumBands, const std::array<float, maxBands>& newThresholds,
+                                      const std::array<float, maxBands>& newDrivesDecibels, const std::array<float, maxBands - 1>& newCrossovers)
+{
+    numBands = juce::jlimit(1, maxBands, newNumBands);
+
+    for (int band = 0; band < maxBands; ++band)
+    {
+        thresholds[(size_t)band] = newThresholds[(size_t)band];
+        drives[(size_t)band] = juce::Decibels::decibelsToGain(newDrivesDecibels[(size_t)band]);
+    }
+
+    // The crossovers have to go up in order and stay under Nyquist, or the bands would overlap.
+    auto lowest = 20.0f;
+    const auto highest = (float)hostSampleRate * 0.45f;
+
+    for (size_t crossover = 0; crossover < crossoverFrequencies.size(); ++crossover)
+    {
+        const auto frequency = juce::jlimit(lowest, highest, newCrossovers[crossover]);
+        lowest = frequency;
+
+        // Working out the coefficients again costs a tan(), so only do it when the frequency moves.
+        if (frequency != crossoverFrequencies[crossover])
+        {
+            crossoverFrequencies[crossover] = frequency;
+            crossovers[crossover].setCutoffFrequency(frequency);
+
+            for (auto& bandAllpasses : allpasses)
+                bandAllpasses[crossover].setCutoffFrequency(frequency);
+        }
+    }
+
+    updateLanes();
+}
+
+double DistortionData::getTailLengthSeconds() const
+{
+    if (numBands == 1)
+        return 0.0;
+
+    // Each half of a Linkwitz-Riley filter is a Butterworth with a Q of 1/sqrt(2), so 2Q ln(1e6) / w comes out
+    // as sqrt(2) ln(1e6) / w. The lowest crossover rings the longest.
+    const auto w = juce::MathConstants<double>::twoPi * crossoverFrequencies[0];
+    return juce::MathConstants<double>::sqrt2 * std::log(1.0e6) / w;
+}
+
+void DistortionData::setShape(const int newShape, const bool useTable)
+{
+    shape = juce::jlimit(0, (int)Waveshaper::Curve::hardClip + 1, newShape);
+
+    if (shape > 0)
+        shaper.setCurve((Waveshaper::Curve)(shape - 1));
+
+    shaper.setMethod(useTable ? Waveshaper::Method::table : Waveshaper::Method::approximation);
+}
+
+template <bool isFolder>
+DistortionData::Lanes DistortionData::shapeLanes(Lanes signal) const
+{
+    if (isFolder)
+        return foldLanes(signal, thresholdLanes, inverseThresholdLanes, driveLanes);
+
+    // The curves all flatten out at 1, so scaling in and out by the threshold makes them flatten out there instead.
+    return thresholdLanes * shaper.process(signal * driveLanes * inverseThresholdLanes);
+}
+
+void DistortionData::updateLanes()
+{
+    alignas(Lanes::SIMDRegisterSize) float thresholdValues[Lanes::size()];
+    alignas(Lanes::SIMDRegisterSize) float inverseValues[Lanes::size()];
+    alignas(Lanes::SIMDRegisterSize) float driveValues[Lanes::size()];
+    alignas(Lanes::SIMDRegisterSize) juce::uint32 maskValues[Lanes::size()];
+
+    for (size_t lane = 0; lane < Lanes::size(); ++lane)
+    {
+        // With a single band the lanes hold consecutive samples instead, so they all share band 0's settings.
+        const auto band = numBands == 1 ? 0 : juce::jmin(lane, (size_t)maxBands - 1);
+        const auto threshold = juce::jmax(minimumThreshold, thresholds[band]);
+
+        thresholdValues[lane] = threshold;
+        inverseValues[lane] = 1.0f / threshold;
+        driveValues[lane] = drives[band];
+        maskValues[lane] = (int)lane < numBands ? 0xffffffffu : 0u;
+    }
+
+    thresholdLanes = Lanes::fromRawArray(thresholdValues);
+    inverseThresholdLanes = Lanes::fromRawArray(inverseValues);
+    driveLanes = Lanes::fromRawArray(driveValues);
+    bandMask = Lanes::vMaskType::fromRawArray(maskValues);
+}
+
+template <bool isFolder>
+void DistortionData::processSingleBand(juce::dsp::AudioBlock<float>& block)
+{
+    const auto numSamples = (int)block.getNumSamples();
+    const auto numRegisters = (numSamples + (int)Lanes::size() - 1) / (int)Lanes::size();
+
+    // The fold works straight on the channel with whatever instruction set this machine has, and gives the same
+    // output as foldLanes.
+    if (isFolder)
+    {
+        const auto threshold = juce::jmax(minimumThreshold, thresholds[0]);
+        const auto& kernels = SimdKernels::get();
+
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            kernels.fold(block.getChannelPointer(channel), numSamples, threshold, 1.0f / threshold, drives[0]);
+
+        return;
+    }
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* channelData = block.getChannelPointer(channel);
+
+        // The channel isn't necessarily aligned, so it goes through the scratch space to be shaped a register at a time.
+        juce::FloatVectorOperations::copy(bandData, channelData, numSamples);
+
+        for (int i = 0; i < numRegisters; ++i)
+        {
+            auto* lanes = bandData + i * (int)Lanes::size();
+            shapeLanes<isFolder>(Lanes::fromRawArray(lanes)).copyToRawArray(lanes);
+        }
+
+        juce::FloatVectorOperations::copy(channelData, bandData, numSamples);
+    }
+}
+
+template <bool isFolder>
+void DistortionData::processMultiBand(juce::dsp::AudioBlock<float>& block)
+{
+    const auto numSamples = (int)block.getNumSamples();
+    const auto lastBand = numBands - 1;
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* channelData = block.getChannelPointer(channel);
+
+        // Split every sample into its bands first. Each crossover takes what is left above the one before it.
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            auto* bands = bandData + sample * (int)Lanes::size();
+            auto rest = channelData[sample];
+
+            for (int crossover = 0; crossover < lastBand; ++crossover)
+                crossovers[(size_t)crossover].processSample((int)channel, rest, bands[crossover], rest);
+
+            bands[lastBand] = rest;
+
+            // The lower bands missed out on the phase shift of the crossovers above them, so they get it from the allpasses.
+            for (int band = 0; band < lastBand - 1; ++band)
+                for (int crossover = band + 1; crossover < lastBand; ++crossover)
+                    bands[band] = allpasses[(size_t)band][(size_t)crossover].processSample((int)channel, bands[band]);
+        }
+
+        // Then one register per sample shapes every band at once, and adding the lanes together puts the bands back.
+        // The lanes above the last band still hold whatever was in the scratch space before, so they are masked out.
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            auto lanes = Lanes::fromRawArray(bandData + sample * (int)Lanes::size());
+            channelData[sample] = (shapeLanes<isFolder>(lanes) & bandMask).sum();
+        }
+    }
+}
+
+DistortionData::Lanes DistortionData::foldLanes(Lanes signal, Lanes threshold, Lanes inverseThreshold, Lanes drive)
+{
+    const auto one = Lanes::expand(1.0f);
+    const auto driven = signal * drive;
+
+    // How many thresholds the signal has travelled, capped so it stays well inside what a float counts exactly.
+    const auto trips = Lanes::min(Lanes::abs(driven) * inverseThreshold, Lanes::expand(1.0e6f));
+
+    // Where it is within the current pair of trips, up and back down again.
+    const auto position = trips - Lanes::truncate(trips * Lanes::expand(0.5f)) * Lanes::expand(2.0f);
+    const auto folded = threshold * (one - Lanes::abs(one - position));
+
+    // Put the sign back on the lanes that started out negative.
+    const auto isNegative = Lanes::lessThan(driven, Lanes::expand(0.0f));
+    return folded - ((folded + folded) & isNegative);
+}
+
+size_t DistortionData::getFootprintBytes() const
+{
+    // Every Linkwitz-Riley filter keeps four state values per channel.
+    const auto numFilters = crossovers.size() + allpasses.size() * crossovers.size();
+    const auto filterBytes = numFilters * 4 * (size_t)preparedChannels * sizeof(float);
+
+    return (size_t)maxBlockSize * Lanes::size() * sizeof(float) + shaper.getFootprintBytes() + filterBytes;
+}
+
+float DistortionData::waveFolder(float signal, float threshold)
+{
+    // The signal bounces between 0 and the threshold, so after every two trips it is back where it started.
+    // Working out where it is in the current pair of trips gives the same answer as walking through every
+    // trip one at a time, without a loop that never ends when the threshold is 0.
+    threshold = juce::jmax(minimumThreshold, threshold);
+
+    const auto trips = std::abs(signal) / threshold;
+    const auto position = trips - 2.0f * std::floor(trips * 0.5f);
+    const auto output = threshold * (1.0f - std::abs(1.0f - position));
+
+    // Finally, if it is a positive return it, and if it is a negative number convert it back to negative.
+    return signal < 0.0f ? -output : output;
+}
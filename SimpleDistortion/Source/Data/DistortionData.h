@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    DistortionData.h
+    Created: 18 Oct 2026 10:12:41am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Waveshaper.h"
+#include "../../../Shared/DspArena.h"
+#include "../../../Shared/ReBlocker.h"
+#include "../../../Shared/SimdKernels.h"
+
+class DistortionData
+{
+public:
+    // Up to four bands fit across the lanes of a single SIMD register.
+    static constexpr int maxBands{ 4 };
+
+    // What prepareToPlay() takes from the arena for the band scratch space.
+    static size_t getRequiredBytes(int samplesPerBlock);
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels, DspArena& arena);
+    void process(juce::AudioBuffer<float>& buffer);
+    void process(juce::dsp::AudioBlock<float>& block);
+    void reset();
+
+    // A single band over the whole signal, the way it has always worked.
+    void updateParameters(const float newThreshold);
+
+    // Splits the signal into numBands with the crossovers, and folds each band with its own threshold and drive.
+    void updateParameters(const int newNumBands, const std::array<float, maxBands>& newThresholds,
+                          const std::array<float, maxBands>& newDrivesDecibels, const std::array<float, maxBands - 1>& newCrossovers);
+
+    // The SHAPE choice, 0 is the wave folder and the rest are the Waveshaper curves in order.
+    // The curves can come from a lookup table or an approximation, the folder is always worked out directly.
+    void setShape(const int newShape, const bool useTable);
+
+    // How long the crossovers keep ringing after the input stops, down to -120dB. Nothing at all with one band.
+    double getTailLengthSeconds() const;
+
+    // The band scratch space, the shaper's tables, and the crossover and allpass states, which the filters allocate themselves.
+    size_t getFootprintBytes() const;
+
+    static float waveFolder(float signal, float threshold);
+
+private:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static_assert(maxBands <= (int)Lanes::size(), "Every band needs its own lane");
+
+    // The same fold as waveFolder, on every lane at once. Each lane can have its own threshold and drive.
+    // SIMDRegister has no divide, so it takes one over the threshold as well.
+    static Lanes foldLanes(Lanes signal, Lanes threshold, Lanes inverseThreshold, Lanes drive);
+
+    // Runs the folder or the selected curve over the lanes with each lane's threshold and drive.
+    template <bool isFolder>
+    Lanes shapeLanes(Lanes signal) const;
+
+    // Copies the per band settings into the lanes, band 0 into every lane when there is only the one band.
+    void updateLanes();
+
+    // The whole signal through one band, four samples at a time.
+    template <bool isFolder>
+    void processSingleBand(juce::dsp::AudioBlock<float>& block);
+
+    // Splits each sample into its bands, one band per lane, then folds and sums them in a single pass.
+    template <bool isFolder>
+    void processMultiBand(juce::dsp::AudioBlock<float>& block);
+
+    // One of the loops above with the shape built in, so the choice is made once a block and not for every register.
+    using Kernel = void (DistortionData::*)(juce::dsp::AudioBlock<float>&);
+
+    // Picks the loop for the current settings, or nullptr when the block would come out the same as it went in.
+    // That is one band of the folder with no drive and nothing in the block reaching the threshold, which is
+    // what the default settings do.
+    Kernel selectKernel(const juce::dsp::AudioBlock<float>& block) const;
+
+    // Below this the threshold is treated as this, otherwise the fold divides by zero.
+    static constexpr float minimumThreshold{ 1.0e-4f };
+
+    int numBands{ 1 };
+
+    // 0 for the folder, otherwise the Waveshaper curve plus one.
+    int shape{ 0 };
+    Waveshaper shaper;
+
+    // The point at which the signal bounces back towards 0, and how much it is pushed into it, for each band.
+    std::array<float, maxBands> thresholds{ 1.0f, 1.0f, 1.0f, 1.0f };
+    std::array<float, maxBands> drives{ 1.0f, 1.0f, 1.0f, 1.0f };
+    std::array<float, maxBands - 1> crossoverFrequencies{ 200.0f, 1000.0f, 5000.0f };
+
+    Lanes thresholdLanes, inverseThresholdLanes, driveLanes;
+
+    // All ones in the lanes that hold a band, so whatever the single band path or a wider register left in the
+    // others never makes it into the sum.
+    Lanes::vMaskType bandMask;
+    double hostSampleRate{ 44100.0 };
+
+    // Each crossover splits what is above the one before it, so the first band ends at crossover 0 and so on.
+    std::array<juce::dsp::LinkwitzRileyFilter<float>, maxBands - 1> crossovers;
+
+    // The lower bands go through the allpass of every crossover above them, so all the bands line up in phase
+    // when they are summed. Only allpasses[band][crossover] with crossover > band are used.
+    std::array<std::array<juce::dsp::LinkwitzRileyFilter<float>, maxBands - 1>, maxBands - 1> allpasses;
+
+    // The bands for every sample of a channel, laid out one register per sample with a band in each lane.
+    // It is a piece of the arena, or of bandFallback when the arena couldn't fit it.
+    float* bandData{ nullptr };
+    juce::HeapBlock<char> bandFallback;
+    int maxBlockSize{ 0 };
+    int preparedChannels{ 0 };
+
+    bool isPrepared{ false };
+};
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    Waveshaper.cpp
+    Created: 18 Oct 2026 7:14:36pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "Waveshaper.h"
+
+void Waveshaper::prepare()
+{
+    // One extra point on the end so the interpolation can always read the point after the one it lands on.
+    for (auto tableCurve : { Curve::tanh, Curve::atan, Curve::tube })
+    {
+        auto& table = tables[(size_t)tableCurve];
+        table.resize((size_t)tableSize + 1);
+
+        for (int i = 0; i <= tableSize; ++i)
+            table[(size_t)i] = exact(tableCurve, juce::jmap((float)i, 0.0f, (float)tableSize, -tableRange, tableRange));
+    }
+}
+
+size_t Waveshaper::getFootprintBytes() const
+{
+    size_t bytes = 0;
+
+    for (const auto& table : tables)
+        bytes += table.size() * sizeof(float);
+
+    return bytes;
+}
+
+Waveshaper::Lanes Waveshaper::process(Lanes signal) const
+{
+    // Clipping is just a min and a max, there is nothing to look up or approximate.
+    if (curve == Curve::hardClip)
+        return Lanes::min(Lanes::max(signal, Lanes::expand(-1.0f)), Lanes::expand(1.0f));
+
+    return method == Method::table ? lookup(signal) : approximate(curve, signal);
+}
+
+float Waveshaper::exact(const Curve curve, const float signal)
+{
+    switch (curve)
+    {
+        case Curve::tanh:     return std::tanh(signal);
+        case Curve::atan:     return std::atan(signal) * 2.0f / juce::MathConstants<float>::pi;
+        case Curve::tube:     return (std::tanh(signal + tubeBias) - std::tanh(tubeBias)) / (1.0f + std::tanh(tubeBias));
+        case Curve::hardClip: return juce::jlimit(-1.0f, 1.0f, signal);
+        default:              break;
+    }
+
+    return signal;
+}
+
+Waveshaper::Lanes Waveshaper::lookup(Lanes signal) const
+{
+    const auto& table = tables[(size_t)curve];
+    jassert(! table.empty());
+
+    // Where each lane lands in the table, kept far enough from the end that the next point is still there.
+    const auto scale = (float)tableSize / (2.0f * tableRange);
+    auto position = (signal + Lanes::expand(tableRange)) * Lanes::expand(scale);
+    position = Lanes::min(Lanes::max(position, Lanes::expand(0.0f)), Lanes::expand((float)tableSize - 0.001f));
+
+    const auto index = Lanes::truncate(position);
+    const auto fraction = position - index;
+
+    // There is no gather in SIMDRegister, so the two points either side are fetched a lane at a time.
+    alignas(Lanes::SIMDRegisterSize) float indices[Lanes::size()];
+    alignas(Lanes::SIMDRegisterSize) float below[Lanes::size()];
+    alignas(Lanes::SIMDRegisterSize) float above[Lanes::size()];
+    index.copyToRawArray(indices);
+
+    for (size_t lane = 0; lane < Lanes::size(); ++lane)
+    {
+        const auto i = (size_t)indices[lane];
+        below[lane] = table[i];
+        above[lane] = table[i + 1];
+    }
+
+    const auto belowLanes = Lanes::fromRawArray(below);
+    return belowLanes + (Lanes::fromRawArray(above) - belowLanes) * fraction;
+}
+
+Waveshaper::Lanes Waveshaper::approximate(const Curve curve, Lanes signal)
+{
+    switch (curve)
+    {
+        case Curve::tanh:
+            return approximateTanh(signal);
+
+        case Curve::atan:
+            return approximateAtan(signal);
+
+        case Curve::tube:
+        {
+            const auto offset = std::tanh(tubeBias);
+            return (approximateTanh(signal + Lanes::expand(tubeBias)) - Lanes::expand(offset)) * Lanes::expand(1.0f / (1.0f + offset));
+        }
+
+        case Curve::hardClip:
+        default:
+            break;
+    }
+
+    return Lanes::min(Lanes::max(signal, Lanes::expand(-1.0f)), Lanes::expand(1.0f));
+}
+
+Waveshaper::Lanes Waveshaper::approximateTanh(Lanes signal)
+{
+    // The 7/6 Pade approximant of tanh. Past +-4.97 it goes over 1, which is where tanh is as good as 1 anyway.
+    const auto x = Lanes::min(Lanes::max(signal, Lanes::expand(-4.97f)), Lanes::expand(4.97f));
+    const auto x2 = x * x;
+
+    const auto numerator = x * (Lanes::expand(135135.0f) + x2 * (Lanes::expand(17325.0f) + x2 * (Lanes::expand(378.0f) + x2)));
+    const auto denominator = Lanes::expand(135135.0f) + x2 * (Lanes::expand(62370.0f) + x2 * (Lanes::expand(3150.0f) + x2 * Lanes::expand(28.0f)));
+
+    return Lanes::min(Lanes::max(divide(numerator, denominator), Lanes::expand(-1.0f)), Lanes::expand(1.0f));
+}
+
+Waveshaper::Lanes Waveshaper::approximateAtan(Lanes signal)
+{
+    const auto one = Lanes::expand(1.0f);
+    const auto halfPi = Lanes::expand(juce::MathConstants<float>::halfPi);
+    const auto magnitude = Lanes::abs(signal);
+
+    // The polynomial is only good between 0 and 1, so above that it works on 1/x and uses atan(x) = pi/2 - atan(1/x).
+    const auto isLarge = Lanes::greaterThan(magnitude, one);
+    const auto z = divide(Lanes::min(magnitude, one), Lanes::max(magnitude, one));
+    const auto z2 = z * z;
+
+    // Minimax polynomial for atan on [0, 1], good to about 1e-5.
+    auto result = Lanes::expand(-0.01172120f);
+    result = result * z2 + Lanes::expand(0.05265332f);
+    result = result * z2 + Lanes::expand(-0.11643287f);
+    result = result * z2 + Lanes::expand(0.19354346f);
+    result = result * z2 + Lanes::expand(-0.33262347f);
+    result = result * z2 + Lanes::expand(0.99997726f);
+    result = result * z;
+
+    result = select(isLarge, halfPi - result, result);
+
+    // Put the sign back and scale it so it flattens out at +-1 like the others.
+    result = select(Lanes::lessThan(signal, Lanes::expand(0.0f)), Lanes::expand(0.0f) - result, result);
+    return result * Lanes::expand(2.0f / juce::MathConstants<float>::pi);
+}
+
+Waveshaper::Lanes Waveshaper::divide(Lanes numerator, Lanes denominator)
+{
+    alignas(Lanes::SIMDRegisterSize) float top[Lanes::size()];
+    alignas(Lanes::SIMDRegisterSize) float bottom[Lanes::size()];
+    numerator.copyToRawArray(top);
+    denominator.copyToRawArray(bottom);
+
+    for (size_t lane = 0; lane < Lanes::size(); ++lane)
+        top[lane] /= bottom[lane];
+
+    return Lanes::fromRawArray(top);
+}
+
+Waveshaper::Lanes Waveshaper::select(Lanes::vMaskType mask, Lanes ifTrue, Lanes ifFalse)
+{
+    return ifFalse + ((ifTrue - ifFalse) & mask);
+}
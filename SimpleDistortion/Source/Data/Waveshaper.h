@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    Waveshaper.h
+    Created: 18 Oct 2026 7:14:36pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// A family of saturation curves, each of which flattens out at -1 below. All but the tube flatten out at +1 above
+// too, the tube stops at (1 - tanh(tubeBias)) / (1 + tanh(tubeBias)), about 0.55. Every curve can be worked out
+// two ways, from a lookup table built in prepare() or from an approximation that only needs a few multiplies, and
+// both run on a whole SIMDRegister at once so std::tanh and friends never get called on the audio thread.
+class Waveshaper
+{
+public:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+
+    enum class Curve { tanh, atan, tube, hardClip };
+    enum class Method { table, approximation };
+
+    // Builds the lookup tables, so it allocates and belongs in prepareToPlay.
+    void prepare();
+
+    // The memory the tables take up.
+    size_t getFootprintBytes() const;
+
+    void setCurve(const Curve newCurve) { curve = newCurve; }
+    void setMethod(const Method newMethod) { method = newMethod; }
+
+    Lanes process(Lanes signal) const;
+
+    // The curves worked out properly with std:: maths. Used to fill the tables, and as the reference in the benchmark.
+    static float exact(const Curve curve, const float signal);
+
+    // Times every curve both ways against std:: per sample, and how far each one strays from it.
+    // It is in WaveshaperBenchmark.cpp, which only RenderCheck builds.
+    static juce::String runBenchmark(const int numSamples = 1 << 20);
+
+private:
+    Lanes lookup(Lanes signal) const;
+    static Lanes approximate(const Curve curve, Lanes signal);
+
+    static Lanes approximateTanh(Lanes signal);
+    static Lanes approximateAtan(Lanes signal);
+
+    // SIMDRegister has no divide, but a loop over the lanes is simple enough for the compiler to turn into one.
+    static Lanes divide(Lanes numerator, Lanes denominator);
+
+    // Picks ifTrue in the lanes where the mask is set and ifFalse everywhere else.
+    static Lanes select(Lanes::vMaskType mask, Lanes ifTrue, Lanes ifFalse);
+
+    // Pushes the tube curve off centre so its two halves clip differently, which is where the even harmonics come from.
+    // It stays scaled to reach -1, so the positive half saturates lower, at about 0.55.
+    static constexpr float tubeBias{ 0.3f };
+
+    // The tables cover -tableRange to tableRange, outside that they hold their last value.
+    static constexpr float tableRange{ 16.0f };
+    static constexpr int tableSize{ 4096 };
+
+    std::array<std::vector<float>, 4> tables;
+
+    Curve curve{ Curve::tanh };
+    Method method{ Method::approximation };
+};
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    WaveshaperBenchmark.cpp
+    Created: 19 Oct 2026 3:58:44am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "Waveshaper.h"
+
+// This is only built into RenderCheck, the plugins have no use for it.
+juce::String Waveshaper::runBenchmark(const int numSamples)
+{
+    const auto numRegisters = numSamples / (int)Lanes::size();
+    const auto length = numRegisters * (int)Lanes::size();
+
+    // Random input over the range where the curves actually bend, lined up for the SIMD loads.
+    juce::HeapBlock<char> memory((size_t)length * 2 * sizeof(float) + Lanes::SIMDRegisterSize);
+    auto* input = juce::snapPointerToAlignment(reinterpret_cast<float*>(memory.get()), Lanes::SIMDRegisterSize);
+    auto* output = input + length;
+
+    juce::Random random(1234);
+
+    for (int i = 0; i < length; ++i)
+        input[i] = random.nextFloat() * 8.0f - 4.0f;
+
+    // Nanoseconds per sample for whatever the lambda does over the whole input.
+    auto time = [&](auto&& body)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        body();
+        const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / (double)length;
+    };
+
+    // The largest difference from std:: maths, which also stops the compiler throwing the work away.
+    auto worstError = [&](Curve curve)
+    {
+        auto error = 0.0f;
+
+        for (int i = 0; i < length; ++i)
+            error = juce::jmax(error, std::abs(output[i] - exact(curve, input[i])));
+
+        return error;
+    };
+
+    juce::String report;
+    const juce::StringArray names{ "tanh", "atan", "tube", "hard clip" };
+
+    for (auto curve : { Curve::tanh, Curve::atan, Curve::tube, Curve::hardClip })
+    {
+        const auto exactTime = time([&]
+        {
+            for (int i = 0; i < length; ++i)
+                output[i] = exact(curve, input[i]);
+        });
+
+        report << names[(int)curve].paddedRight(' ', 10) << "std " << juce::String(exactTime, 2) << " ns";
+
+        for (auto method : { Method::table, Method::approximation })
+        {
+            Waveshaper shaper;
+            shaper.prepare();
+            shaper.setCurve(curve);
+            shaper.setMethod(method);
+
+            const auto shaperTime = time([&]
+            {
+                for (int i = 0; i < numRegisters; ++i)
+                {
+                    auto* lanes = input + i * (int)Lanes::size();
+                    shaper.process(Lanes::fromRawArray(lanes)).copyToRawArray(output + i * (int)Lanes::size());
+                }
+            });
+
+            report << (method == Method::table ? "   table " : "   approximation ") << juce::String(shaperTime, 2) << " ns"
+                   << " (" << juce::String(exactTime / shaperTime, 1) << "x, error " << juce::String(worstError(curve), 6) << ")";
+        }
+
+        report << juce::newLine;
+    }
+
+    return report;
+}
@@ -11,11 +11,43 @@
 
 //==============================================================================
 SimpleDistortionAudioProcessorEditor::SimpleDistortionAudioProcessorEditor (SimpleDistortionAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p), analyzer (p.getAnalyzerSource())
 {
+    auto& apvts = audioProcessor.getAPVTS();
+
+    // Band 1 keeps the original THRESHOLD and DRIVE IDs, the others have their number on the end.
+    for (int band = 0; band < DistortionData::maxBands; ++band)
+    {
+        const auto suffix = band == 0 ? juce::String() : juce::String(band + 1);
+        attachments.push_back(std::make_unique<Attach>(apvts, "THRESHOLD" + suffix, thresholdSliders[(size_t)band]));
+        attachments.push_back(std::make_unique<Attach>(apvts, "DRIVE" + suffix, driveSliders[(size_t)band]));
+
+        setupSlider(thresholdSliders[(size_t)band]);
+        setupSlider(driveSliders[(size_t)band]);
+    }
+
+    for (int crossover = 0; crossover < DistortionData::maxBands - 1; ++crossover)
+    {
+        attachments.push_back(std::make_unique<Attach>(apvts, "CROSSOVER" + juce::String(crossover + 1), crossoverSliders[(size_t)crossover]));
+        setupSlider(crossoverSliders[(size_t)crossover]);
+    }
+
+    // The combo boxes have to have their items before the attachments are made so they can pick the right one.
+    const juce::StringArray choiceIDs{ "BANDS", "SHAPE", "SHAPEMODE" };
+
+    for (int i = 0; i < choiceIDs.size(); ++i)
+    {
+        auto& box = choiceBoxes[(size_t)i];
+        box.addItemList(apvts.getParameter(choiceIDs[i])->getAllValueStrings(), 1);
+        choiceAttachments.push_back(std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, choiceIDs[i], box));
+        addAndMakeVisible(box);
+    }
+
+    addAndMakeVisible(analyzer);
+
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize (400, 300);
+    setSize (480, 480);
 }
 
 SimpleDistortionAudioProcessorEditor::~SimpleDistortionAudioProcessorEditor()
@@ -27,14 +59,39 @@ void SimpleDistortionAudioProcessorEditor::paint (juce::Graphics& g)
 {
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::white);
-    g.setFont (15.0f);
-    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
 }
 
 void SimpleDistortionAudioProcessorEditor::resized()
 {
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
+    auto bounds = getLocalBounds();
+
+    // The analyzer goes along the top, then a row of thresholds, a row of drives, and the crossovers at the bottom.
+    analyzer.setBounds(bounds.removeFromTop(bounds.getHeight() * 2 / 5).reduced(5));
+
+    const auto rowHeight = bounds.getHeight() / 3;
+    auto thresholdRow = bounds.removeFromTop(rowHeight);
+    auto driveRow = bounds.removeFromTop(rowHeight);
+    const auto columnWidth = bounds.getWidth() / DistortionData::maxBands;
+
+    for (size_t band = 0; band < thresholdSliders.size(); ++band)
+    {
+        thresholdSliders[band].setBounds(thresholdRow.removeFromLeft(columnWidth));
+        driveSliders[band].setBounds(driveRow.removeFromLeft(columnWidth));
+    }
+
+    // The crossovers go along the bottom, with the choices stacked up in the last column.
+    for (auto& slider : crossoverSliders)
+        slider.setBounds(bounds.removeFromLeft(columnWidth));
+
+    const auto boxHeight = bounds.getHeight() / (int)choiceBoxes.size();
+
+    for (auto& box : choiceBoxes)
+        box.setBounds(bounds.removeFromTop(boxHeight).withSizeKeepingCentre(bounds.getWidth() - 10, juce::jmin(24, boxHeight - 4)));
+}
+
+void SimpleDistortionAudioProcessorEditor::setupSlider(juce::Slider& slider)
+{
+    slider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+    slider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+    addAndMakeVisible(slider);
 }
@@ -24,10 +24,28 @@ public:
     void paint (juce::Graphics&) override;
     void resized() override;
 
+    void setupSlider(juce::Slider& slider);
+
 private:
+    using Attach = juce::AudioProcessorValueTreeState::SliderAttachment;
+
+    // A threshold and a drive for every band, and the crossovers between them.
+    std::array<juce::Slider, DistortionData::maxBands> thresholdSliders;
+    std::array<juce::Slider, DistortionData::maxBands> driveSliders;
+    std::array<juce::Slider, DistortionData::maxBands - 1> crossoverSliders;
+
+    std::vector<std::unique_ptr<Attach>> attachments;
+
+    // The band count, the shape, and whether the shape comes from a table or an approximation.
+    std::array<juce::ComboBox, 3> choiceBoxes;
+    std::vector<std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>> choiceAttachments;
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     SimpleDistortionAudioProcessor& audioProcessor;
 
+    // Shows the spectrum of the output above the sliders.
+    SpectrumAnalyzer analyzer;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleDistortionAudioProcessorEditor)
 };
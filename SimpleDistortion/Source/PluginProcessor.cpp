@@ -22,6 +22,23 @@ SimpleDistortionAudioProcessor::SimpleDistortionAudioProcessor()
                        ), apvts(*this, nullptr, "PARAMETERS", createParameters())
 #endif
 {
+    // Controller 20 onwards drive the parameters in the order they were added, skipping any the MIDI spec defines.
+    scheduler.mapControllers(getParameters(), firstMappedController, &apvts);
+
+    // Looking the parameters up by ID every segment would mean a string search each time, so keep hold of them.
+    numBandsParameter = apvts.getRawParameterValue("BANDS");
+    shapeParameter = apvts.getRawParameterValue("SHAPE");
+    shapeModeParameter = apvts.getRawParameterValue("SHAPEMODE");
+
+    for (int band = 0; band < DistortionData::maxBands; ++band)
+    {
+        const auto suffix = band == 0 ? juce::String() : juce::String(band + 1);
+        thresholdParameters[(size_t)band] = apvts.getRawParameterValue("THRESHOLD" + suffix);
+        driveParameters[(size_t)band] = apvts.getRawParameterValue("DRIVE" + suffix);
+    }
+
+    for (int crossover = 0; crossover < DistortionData::maxBands - 1; ++crossover)
+        crossoverParameters[(size_t)crossover] = apvts.getRawParameterValue("CROSSOVER" + juce::String(crossover + 1));
 }
 
 SimpleDistortionAudioProcessor::~SimpleDistortionAudioProcessor()
@@ -68,39 +85,49 @@ double SimpleDistortionAudioProcessor::getTailLengthSeconds() const
 
 int SimpleDistortionAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if you're not really implementing programs.
+    return juce::jmax(1, presets.getNumPresets());
 }
 
 int SimpleDistortionAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presets.getCurrentPreset();
 }
 
 void SimpleDistortionAudioProcessor::setCurrentProgram (int index)
 {
+    // Only queues the preset, the audio thread switches over to it at the next block.
+    presets.selectPreset(index);
 }
 
 const juce::String SimpleDistortionAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presets.getPresetName(index);
 }
 
 void SimpleDistortionAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    presets.renamePreset(index, newName);
 }
 
 //==============================================================================
 void SimpleDistortionAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    // The same spec as last time fits in the slab that's already there, so nothing gets allocated.
+    arena.prepare(DistortionData::getRequiredBytes(samplesPerBlock));
+    distortion.prepareToPlay(sampleRate, samplesPerBlock, getTotalNumOutputChannels(), arena);
+    scheduler.prepareToPlay(sampleRate, samplesPerBlock);
+    presets.prepareToPlay(sampleRate);
+    silence.prepareToPlay(sampleRate, samplesPerBlock);
+    analyzerSource.prepareToPlay(sampleRate, samplesPerBlock);
 }
 
 void SimpleDistortionAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    presets.releaseResources();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -132,6 +159,60 @@ bool SimpleDistortionAudioProcessor::isBusesLayoutSupported (const BusesLayout&
 void SimpleDistortionAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    const auto isActive = beginBlock(buffer);
+
+    // This is the place where you'd normally do the guts of your plugin's
+    // audio processing...
+    // Make sure to reset the state if your inner loop is processing
+    // the samples and the outer loop is handling the channels.
+    // Alternatively, you can process the samples with the channels
+    // interleaved by keeping the same state.
+    juce::dsp::AudioBlock<float> block{ buffer };
+
+    // The parameters are read again for every segment, so a controller change lands on the right sample.
+    scheduler.process(buffer.getNumSamples(), midiMessages, [&](int startSample, int numSamples)
+    {
+        // Asleep, so the segments only go by to keep the mapped controllers moving.
+        if (! isActive)
+            return;
+
+        // The wave folding itself lives in DistortionData so it can be shared with other processors.
+        updateParameters();
+
+        auto subBlock = block.getSubBlock((size_t)startSample, (size_t)numSamples);
+        distortion.process(subBlock);
+    });
+
+    endBlock(buffer);
+}
+
+void SimpleDistortionAudioProcessor::processBatch (SimpleDistortionAudioProcessor* const* processors, juce::AudioBuffer<float>* const* buffers,
+                                                   int numProcessors)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    for (int i = 0; i < numProcessors; ++i)
+    {
+        auto& processor = *processors[i];
+        auto& buffer = *buffers[i];
+
+        if (! processor.beginBlock(buffer))
+        {
+            processor.endBlock(buffer);
+            continue;
+        }
+
+        processor.updateParameters();
+
+        juce::dsp::AudioBlock<float> block{ buffer };
+        processor.distortion.process(block);
+
+        processor.endBlock(buffer);
+    }
+}
+
+bool SimpleDistortionAudioProcessor::beginBlock (juce::AudioBuffer<float>& buffer)
+{
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -144,53 +225,31 @@ void SimpleDistortionAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // This is the place where you'd normally do the guts of your plugin's
-    // audio processing...
-    // Make sure to reset the state if your inner loop is processing
-    // the samples and the outer loop is handling the channels.
-    // Alternatively, you can process the samples with the channels
-    // interleaved by keeping the same state.
-    float threshold = apvts.getRawParameterValue("THRESHOLD")->load();
-    
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
-    {
-        // Get a write pointer to the current channel
-        auto* channelData = buffer.getWritePointer (channel);
+    // Switches to a newly selected preset once the output has faded out for it.
+    presets.beginBlock();
 
-        // Increment over all the samples in the buffer.
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-        {
-            // Call the Wave Folder algorithm on the sample and save it back.
-            channelData[sample] = waveFolder(channelData[sample], threshold);
-        }
+    // While nothing is coming in or ringing out, the block is left as zeros and the DSP below is skipped.
+    const auto isActive = silence.beginBlock(buffer);
 
-            /*// Store the input temporarily
-            float input = channelData[sample];
-
-            // If the input is greater than the threshold, fold...
-            if (input > threshold)
-            {
-                // This means first calculate the part above the threshold
-                float aboveThreshold = input - threshold;
-
-                // The make it that amount below the threshold
-                channelData[sample] = threshold - aboveThreshold;
-            }
-            // If the signal is over in the negative direction
-            else if (input < -threshold)
-            {
-                // Calculate the amount below the negative of the threshold, or input - (-threshold)
-                float belowThreshold = input + threshold;
-
-                // Then it is the same equation as before with threshold negative and belowThreshold while be positive.
-                channelData[sample] = -threshold - belowThreshold; 
-            }
-            else
-            {
-                // No folding has occured.
-                channelData[sample] = input;
-            } */
-    }
+    if (! isActive)
+        buffer.clear();
+
+    return isActive;
+}
+
+void SimpleDistortionAudioProcessor::endBlock (juce::AudioBuffer<float>& buffer)
+{
+    // The wave folder has no memory, only the crossovers ring on for a moment when there is more than one band.
+    silence.setTailLengthSeconds(distortion.getTailLengthSeconds());
+
+    if (silence.endBlock(buffer))
+        distortion.reset();
+
+    // Fades out ahead of a queued preset, or back in after one was applied.
+    presets.endBlock(buffer);
+
+    // Only a copy into a FIFO, the analysis itself happens on the editor's thread.
+    analyzerSource.push(buffer);
 }
 
 //==============================================================================
@@ -201,9 +260,7 @@ bool SimpleDistortionAudioProcessor::hasEditor() const
 
 juce::AudioProcessorEditor* SimpleDistortionAudioProcessor::createEditor()
 {
-    // Used instead to display the apvts by default
-    return new juce::GenericAudioProcessorEditor(this);
-    //return new SimpleDistortionAudioProcessorEditor (*this);
+    return new SimpleDistortionAudioProcessorEditor (*this);
 }
 
 //==============================================================================
@@ -212,75 +269,72 @@ void SimpleDistortionAudioProcessor::getStateInformation (juce::MemoryBlock& des
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
+
+    // Writes every parameter into a small binary blob which is much quicker to load than XML.
+    StateSerializer::save(*this, destData);
 }
 
 void SimpleDistortionAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
-}
-
-juce::AudioProcessorValueTreeState::ParameterLayout SimpleDistortionAudioProcessor::createParameters()
-{
-    // Creates a variable to store the layout
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
 
-    // Adds an AudioParameterFloat to control the threshold value.
-    layout.add(std::make_unique<juce::AudioParameterFloat>("THRESHOLD", "Threshold", 0.0f, 1.0f, 1.0f));
-
-    return layout;
+    // Reads the binary blob back, or the old XML state if that is what the session holds.
+    StateSerializer::load(*this, data, sizeInBytes);
 }
 
-float SimpleDistortionAudioProcessor::waveFolder(float& signal, float& threshold)
+void SimpleDistortionAudioProcessor::updateParameters()
 {
-    // Start assuming it is positive
-    bool isPositive = true;
-
-    // If the signal is negative, convert it to positive and erase the isPositive flag
-    if (signal < 0.0f)
-    { 
-        isPositive = false;
-        signal = -signal;
-    }
+    // The choice is 0 based, so "1" is index 0. A single band skips the crossovers and folds the full band.
+    const auto numBands = (int)numBandsParameter->load() + 1;
 
-    // t = 0.75 s = 1.0    t = 0.2  s = 0.9 i = 5 total Used = 4 * 0.2 = 0.8 total left = 0.1 
+    std::array<float, DistortionData::maxBands> thresholds, drives;
+    std::array<float, DistortionData::maxBands - 1> crossovers;
 
-    // The loop starts at increment 0
-    int i = 0;
-
-    // Until it is on the signals last bouncy journey.
-    while (i * threshold < signal)
+    for (size_t band = 0; band < thresholds.size(); ++band)
     {
-        // Increment the counter
-        i++;
+        thresholds[band] = thresholdParameters[band]->load();
+        drives[band] = driveParameters[band]->load();
     }
 
-    // It was the previous loop index that is the most that can be taken away.
-    i--;
+    for (size_t crossover = 0; crossover < crossovers.size(); ++crossover)
+        crossovers[crossover] = crossoverParameters[crossover]->load();
 
-    // The output defaults to 0
-    float output = 0.0f;
+    distortion.updateParameters(numBands, thresholds, drives, crossovers);
+    distortion.setShape((int)shapeParameter->load(), shapeModeParameter->load() < 0.5f);
+}
 
-    // The total used is the total lengths of the trips between 0 and the threshold minus the last trip.
-    auto totalUsed = (i * threshold);
+juce::AudioProcessorValueTreeState::ParameterLayout SimpleDistortionAudioProcessor::createParameters()
+{
+    // Creates a variable to store the layout
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
 
-    // Then the total left over is easily calculated by minusing the total length of the journey.
-    auto totalLeft = signal - totalUsed;
+    // Adds an AudioParameterFloat to control the threshold value.
+    layout.add(std::make_unique<juce::AudioParameterFloat>("THRESHOLD", "Threshold", 0.0f, 1.0f, 1.0f));
 
-    // If it is a even number, it is just the difference between 0 and the total left.
-    if (i % 2 == 0)
-    {
-        output = totalLeft;
-    }
+    // With one band the threshold above covers everything, with more it is the lowest band's.
+    layout.add(std::make_unique<juce::AudioParameterChoice>("BANDS", "Bands", juce::StringArray{ "1", "2", "3", "4" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("DRIVE", "Drive", 0.0f, 24.0f, 0.0f));
 
-    // If it has made an odd number of trips, it is the distance towards 0 from the threshold.
-    else
+    for (int band = 2; band <= DistortionData::maxBands; ++band)
     {
-        output = threshold - totalLeft;
+        layout.add(std::make_unique<juce::AudioParameterFloat>("THRESHOLD" + juce::String(band), "Threshold " + juce::String(band), 0.0f, 1.0f, 1.0f));
+        layout.add(std::make_unique<juce::AudioParameterFloat>("DRIVE" + juce::String(band), "Drive " + juce::String(band), 0.0f, 24.0f, 0.0f));
     }
 
-    // Finally, if it is a positive return it, and if it is a negative number convert it back to negative.
-    return isPositive ? output : -output;
+    // The crossovers sit between the bands, skewed so the lower frequencies get more of the knob.
+    const juce::StringArray crossoverDefaults{ "200", "1000", "5000" };
+
+    for (int crossover = 1; crossover < DistortionData::maxBands; ++crossover)
+        layout.add(std::make_unique<juce::AudioParameterFloat>("CROSSOVER" + juce::String(crossover), "Crossover " + juce::String(crossover),
+                                                               juce::NormalisableRange<float>(20.0f, 20000.0f, 1.0f, 0.25f),
+                                                               crossoverDefaults[crossover - 1].getFloatValue()));
+
+    // The folder is the original sound, the rest are the Waveshaper curves in the same order as Waveshaper::Curve.
+    layout.add(std::make_unique<juce::AudioParameterChoice>("SHAPE", "Shape", juce::StringArray{ "Fold", "Tanh", "Atan", "Tube", "Hard Clip" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("SHAPEMODE", "Shape Mode", juce::StringArray{ "Table", "Approximation" }, 1));
+
+    return layout;
 }
 
 //==============================================================================
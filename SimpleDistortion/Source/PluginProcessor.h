@@ -9,6 +9,12 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "Data/DistortionData.h"
+#include "../../Shared/SubBlockScheduler.h"
+#include "../../Shared/StateSerializer.h"
+#include "../../Shared/PresetBank.h"
+#include "../../Shared/SilenceDetector.h"
+#include "../../Shared/SpectrumAnalyzer.h"
 
 //==============================================================================
 /**
@@ -33,6 +39,13 @@ public:
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
+    // For a host that runs a lot of these side by side, the same call as SimpleFilterAudioProcessor::processBatch.
+    // There is no MIDI, so the parameters are read once for the whole block. The folder and the curves keep nothing
+    // from one sample to the next, so each one already fills the widest register along its own block, and lining
+    // several of them up across the lanes instead would only add the shuffling. So each processor's block goes
+    // through its own kernel in turn.
+    static void processBatch (SimpleDistortionAudioProcessor* const* processors, juce::AudioBuffer<float>* const* buffers, int numProcessors);
+
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -56,11 +69,57 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
+
+    // The editor's spectrum analyzer reads the output from here.
+    AnalyzerSource& getAnalyzerSource() { return analyzerSource; }
+
+    // Everything this instance holds for its DSP, for keeping an eye on memory with a lot of instances open.
+    size_t getDspFootprintBytes() const { return sizeof(*this) + distortion.getFootprintBytes() + analyzerSource.getFootprintBytes(); }
+
 private:
+    // Every DSP buffer comes out of this, it has to outlive everything using it so it goes first.
+    DspArena arena;
+
     juce::AudioProcessorValueTreeState apvts;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
 
-    float waveFolder(float& signal, float& threshold);
+    // Reads every band's settings and hands them over to the distortion.
+    void updateParameters();
+
+    std::atomic<float>* numBandsParameter{ nullptr };
+    std::atomic<float>* shapeParameter{ nullptr };
+    std::atomic<float>* shapeModeParameter{ nullptr };
+    std::array<std::atomic<float>*, DistortionData::maxBands> thresholdParameters{};
+    std::array<std::atomic<float>*, DistortionData::maxBands> driveParameters{};
+    std::array<std::atomic<float>*, DistortionData::maxBands - 1> crossoverParameters{};
+
+    DistortionData distortion;
+
+    // The parts of processBlock either side of the distortion. beginBlock returns false when the block is silent
+    // and the distortion can be skipped.
+    bool beginBlock(juce::AudioBuffer<float>& buffer);
+    void endBlock(juce::AudioBuffer<float>& buffer);
+
+    // Splits each block up at its MIDI events.
+    SubBlockScheduler scheduler;
+
+    // The first MIDI controller that is mapped to a parameter. 20 to 31 are undefined in the MIDI spec, once
+    // they run out the scheduler carries on from the next undefined one, 85.
+    static constexpr int firstMappedController{ 20 };
+
+    // Every preset as a snapshot of parameter values, switched over without locking.
+    PresetBank presets{ *this, &apvts };
+
+    // Skips the DSP while the input and anything left ringing out are both silent.
+    SilenceDetector silence;
+
+    // The output handed over to the spectrum analyzer.
+    AnalyzerSource analyzerSource;
+
+    // The editor's analyzer runs on the shared worker pool. Holding on to it here keeps the pool going while the
+    // plugin is loaded, rather than it starting and stopping every time the editor opens and closes.
+    juce::SharedResourcePointer<WorkerPool> workerPool;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleDistortionAudioProcessor)
@@ -10,34 +10,273 @@
 
 #include "FilterData.h"
 
+FilterData::FilterData()
+{
+    // What StateVariableFilter::Parameters starts out as, a low pass at 1kHz.
+    setCoefficients(44100.0, 1000.0f, (float)(1.0 / juce::MathConstants<double>::sqrt2));
+}
+
 void FilterData::prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels)
 {
-    filter.reset();
+    juce::ignoreUnused(samplesPerBlock);
 
-    juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.sampleRate = sampleRate;
     hostSampleRate = sampleRate;
-    spec.numChannels = numChannels;
-    filter.prepare(spec);
+    preparedChannels = numChannels;
+
+    // Cleared, so every channel starts from nothing.
+    states.calloc((size_t)juce::jmax(1, numChannels) * 2);
 
     isPrepared = true;
 }
 
 void FilterData::process(juce::AudioBuffer<float>& buffer)
 {
-    jassert(isPrepared);
     juce::dsp::AudioBlock<float> block{ buffer };
-    filter.process(juce::dsp::ProcessContextReplacing<float>{ block });
+    process(block);
+}
+
+void FilterData::process(juce::dsp::AudioBlock<float>& block)
+{
+    jassert(isPrepared);
+
+    guard.protect(block);
+
+    const auto numChannels = juce::jmin((int)block.getNumChannels(), preparedChannels);
+    const auto numSamples = (int)block.getNumSamples();
+
+    // The type is picked once for the whole channel rather than on every sample.
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* data = block.getChannelPointer((size_t)channel);
+
+        switch (filterType)
+        {
+            case 1:  processChannel<1>(data, numSamples, channel); break;
+            case 2:  processChannel<2>(data, numSamples, channel); break;
+            default: processChannel<0>(data, numSamples, channel); break;
+        }
+    }
+
+    endBlock(block);
+}
+
+void FilterData::processBatch(FilterData* const* filters, juce::dsp::AudioBlock<float>* blocks, int numFilters)
+{
+    if (numFilters <= 0)
+        return;
+
+    constexpr auto numLanes = (int)Lanes::size();
+    const auto numSamples = (int)blocks[0].getNumSamples();
+
+    // Channels are gathered up by type, so each register only ever has one type in it and picks its output
+    // the same way process() does. A register is run as soon as it is full.
+    Lane pending[3][numLanes];
+    int numPending[3]{};
+
+    auto flush = [&](int type)
+    {
+        switch (type)
+        {
+            case 1:  processLanes<1>(pending[1], numPending[1], numSamples); break;
+            case 2:  processLanes<2>(pending[2], numPending[2], numSamples); break;
+            default: processLanes<0>(pending[0], numPending[0], numSamples); break;
+        }
+
+        numPending[type] = 0;
+    };
+
+    for (int i = 0; i < numFilters; ++i)
+    {
+        auto& filter = *filters[i];
+        auto& block = blocks[i];
+
+        jassert(filter.isPrepared);
+        jassert((int)block.getNumSamples() == numSamples);
+
+        filter.guard.protect(block);
+
+        const auto type = filter.filterType;
+        const auto numChannels = juce::jmin((int)block.getNumChannels(), filter.preparedChannels);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            pending[type][numPending[type]++] = { &filter, block.getChannelPointer((size_t)channel), channel };
+
+            if (numPending[type] == numLanes)
+                flush(type);
+        }
+    }
+
+    for (int type = 0; type < 3; ++type)
+        if (numPending[type] > 0)
+            flush(type);
+
+    for (int i = 0; i < numFilters; ++i)
+        filters[i]->endBlock(blocks[i]);
+}
+
+template <int type>
+void FilterData::processChannel(float* data, int numSamples, int channel) noexcept
+{
+    auto s1 = states[channel * 2];
+    auto s2 = states[channel * 2 + 1];
+    float outputs[3];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        tick(data[i], s1, s2, g, R2, h, outputs[0], outputs[1], outputs[2]);
+        data[i] = outputs[type];
+    }
+
+    states[channel * 2] = s1;
+    states[channel * 2 + 1] = s2;
+}
+
+template <int type>
+void FilterData::processLanes(const Lane* lanes, int numLanes, int numSamples) noexcept
+{
+    constexpr auto size = (int)Lanes::size();
+
+    // The lanes past numLanes are left at zero, which keeps them at zero.
+    alignas(Lanes::SIMDRegisterSize) float values[5][size]{};
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        const auto& filter = *lanes[lane].filter;
+        const auto channel = lanes[lane].channel;
+
+        values[0][lane] = filter.g;
+        values[1][lane] = filter.R2;
+        values[2][lane] = filter.h;
+        values[3][lane] = filter.states[channel * 2];
+        values[4][lane] = filter.states[channel * 2 + 1];
+    }
+
+    const auto g = Lanes::fromRawArray(values[0]);
+    const auto R2 = Lanes::fromRawArray(values[1]);
+    const auto h = Lanes::fromRawArray(values[2]);
+    auto s1 = Lanes::fromRawArray(values[3]);
+    auto s2 = Lanes::fromRawArray(values[4]);
+
+    // The channels are interleaved a chunk at a time, so the loop itself loads and stores whole registers.
+    constexpr int chunkSize = 64;
+    alignas(Lanes::SIMDRegisterSize) float interleaved[chunkSize * size]{};
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const auto length = juce::jmin(chunkSize, numSamples - start);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const auto* data = lanes[lane].data + start;
+
+            for (int i = 0; i < length; ++i)
+                interleaved[i * size + lane] = data[i];
+        }
+
+        for (int i = 0; i < length; ++i)
+        {
+            auto* samples = interleaved + i * size;
+            Lanes outputs[3];
+
+            tick(Lanes::fromRawArray(samples), s1, s2, g, R2, h, outputs[0], outputs[1], outputs[2]);
+            outputs[type].copyToRawArray(samples);
+        }
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            auto* data = lanes[lane].data + start;
+
+            for (int i = 0; i < length; ++i)
+                data[i] = interleaved[i * size + lane];
+        }
+    }
+
+    s1.copyToRawArray(values[3]);
+    s2.copyToRawArray(values[4]);
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto& filter = *lanes[lane].filter;
+        const auto channel = lanes[lane].channel;
+
+        filter.states[channel * 2] = values[3][lane];
+        filter.states[channel * 2 + 1] = values[4][lane];
+    }
+}
+
+void FilterData::endBlock(juce::dsp::AudioBlock<float>& block)
+{
+    for (int i = 0; i < preparedChannels * 2; ++i)
+        juce::dsp::util::snapToZero(states[i]);
+
+    // A NaN or a blow up only clears this filter, not the rest of a batch.
+    if (! FeedbackGuard::isHealthy(block))
+    {
+        reset();
+        block.clear();
+    }
 }
 
 void FilterData::reset()
 {
-    filter.reset();
+    if (states != nullptr)
+        juce::FloatVectorOperations::clear(states.get(), preparedChannels * 2);
 }
 
-void FilterData::updateParameters(const int frequency, const float resonance)
+void FilterData::updateParameters(const int frequency, const float resonance, const int type)
 {
-    filter.parameters->type = juce::dsp::StateVariableFilter::StateVariableFilterType::lowPass;
-    filter.parameters->setCutOffFrequency(hostSampleRate, frequency, resonance);
+    // 0 is the low pass output of the filter, 1 the band pass and 2 the high pass.
+    filterType = type == 1 || type == 2 ? type : 0;
+
+    // Automation that hands over a bad resonance would put NaNs straight into the coefficients.
+    if (! std::isfinite(resonance) || resonance <= 0.0f)
+        return;
+
+    setCoefficients(hostSampleRate, (float)frequency, resonance);
+
+    currentFrequency = (float)frequency;
+    currentResonance = resonance;
+}
+
+void FilterData::setCoefficients(double sampleRate, float frequency, float resonance)
+{
+    // The mix of float and double is on purpose, it is exactly what StateVariableFilter::Parameters does.
+    g = static_cast<float>(std::tan(juce::MathConstants<double>::pi * frequency / sampleRate));
+    R2 = static_cast<float>(1.0 / resonance);
+    h = static_cast<float>(1.0 / (1.0 + R2 * g + g * g));
+}
+
+double FilterData::getTailLengthSeconds() const
+{
+    // A resonant filter rings with an envelope of exp(-w t / 2Q), so getting down by 1e-6 takes 2Q ln(1e6) / w.
+    const auto w = juce::MathConstants<double>::twoPi * juce::jmax(1.0f, currentFrequency);
+    return 2.0 * juce::jmax(0.5f, currentResonance) * std::log(1.0e6) / w;
+}
+
+void FilterData::getMagnitudeResponse(const int type, const float frequency, const float resonance, const double sampleRate,
+                                      const float* warpedFrequencies, float* magnitudes, const int numPoints)
+{
+    // Same prewarping as the filter itself, see setCoefficients.
+    const auto g = (float)std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+    const auto inverseG = 1.0f / g;
+    const auto R2 = 1.0f / resonance;
+
+    // The filter is the bilinear transform of 1 / (s^2 + R2 s + 1), so at each frequency s = jx where
+    // x = tan(pi f / fs) / g. The low, band and high pass outputs put 1, x and x^2 over the same denominator,
+    // so the type only picks which of those goes on top and the loop doesn't need to branch.
+    const auto lowWeight = type == 0 ? 1.0f : 0.0f;
+    const auto bandWeight = type == 1 ? 1.0f : 0.0f;
+    const auto highWeight = type == 2 ? 1.0f : 0.0f;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto x = warpedFrequencies[i] * inverseG;
+        const auto xSquared = x * x;
+        const auto real = 1.0f - xSquared;
+        const auto imaginary = R2 * x;
+
+        const auto numerator = lowWeight + bandWeight * x + highWeight * xSquared;
+        magnitudes[i] = numerator / std::sqrt(real * real + imaginary * imaginary);
+    }
 }
@@ -10,17 +10,96 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "../../../Shared/FeedbackGuard.h"
 
 class FilterData
 {
 public:
+    FilterData();
+
     void prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels);
     void process(juce::AudioBuffer<float>& buffer);
+    void process(juce::dsp::AudioBlock<float>& block);
     void reset();
-    void updateParameters(const int frequency, const float resonance);
+
+    // Runs numFilters filters over their own blocks with the channels of several filters side by side in the lanes
+    // of one SIMD register, so a host with a lot of them can fill the register instead of going one channel at a
+    // time. Every filter keeps its own parameters and state, and comes out exactly as process() would have left it.
+    // The blocks all have to be the same length.
+    static void processBatch(FilterData* const* filters, juce::dsp::AudioBlock<float>* blocks, int numFilters);
+    // The type follows the TYPE choice parameter, 0 is low pass, 1 band pass and 2 high pass.
+    void updateParameters(const int frequency, const float resonance, const int type = 0);
+
+    // The two integrator states of every channel.
+    size_t getFootprintBytes() const { return (size_t)preparedChannels * 2 * sizeof(float); }
+
+    // How long the filter rings for after its input stops, down to -120dB.
+    double getTailLengthSeconds() const;
+
+    // Fills magnitudes with the gain of the filter at each frequency, without touching any filter state.
+    // warpedFrequencies holds tan(pi * f / sampleRate) for every frequency, so that part only has to be
+    // worked out again when the sample rate changes and the loop itself is plain arithmetic that vectorizes.
+    static void getMagnitudeResponse(const int type, const float frequency, const float resonance, const double sampleRate,
+                                     const float* warpedFrequencies, float* magnitudes, const int numPoints);
 
 private:
-    juce::dsp::StateVariableFilter::Filter<float> filter;
+    using Lanes = juce::dsp::SIMDRegister<float>;
+
+    // One step of the TPT state variable filter, the same as juce::dsp::StateVariableFilter's and in the same order,
+    // for a single channel or a register full of them. All three outputs come out of every step.
+    template <typename SampleType>
+    static void tick(const SampleType input, SampleType& s1, SampleType& s2, const SampleType g, const SampleType R2,
+                     const SampleType h, SampleType& low, SampleType& band, SampleType& high) noexcept
+    {
+        high = (input - s1 * R2 - s1 * g - s2) * h;
+        band = high * g + s1;
+        s1 = high * g + band;
+        low = band * g + s2;
+        s2 = band * g + low;
+    }
+
+    template <int type>
+    void processChannel(float* data, int numSamples, int channel) noexcept;
+
+    // A channel of one of the filters in a batch.
+    struct Lane
+    {
+        FilterData* filter;
+        float* data;
+        int channel;
+    };
+
+    // Runs up to a register's worth of channels that all have the same type, one lane each.
+    template <int type>
+    static void processLanes(const Lane* lanes, int numLanes, int numSamples) noexcept;
+
+    // The filter used to be juce::dsp::StateVariableFilter, which snaps its states to zero at the end of every block.
+    // Doing the same keeps the output identical.
+    void endBlock(juce::dsp::AudioBlock<float>& block);
+
+    // Two states per channel, s1 then s2.
+    juce::HeapBlock<float> states;
+
+    // The prewarped cutoff, one over the resonance and the gain that ties them together, worked out the same
+    // way as StateVariableFilter::Parameters.
+    void setCoefficients(double sampleRate, float frequency, float resonance);
+
+    float g{ 0.0f };
+    float R2{ 0.0f };
+    float h{ 0.0f };
+    int filterType{ 0 };
+
     bool isPrepared{ false };
+    int preparedChannels{ 0 };
+
+    // A NaN in the integrators would stay there forever, so a block that comes out bad resets the filter.
+    // The denormal protection is always the guard's DC offset, never the noise. It goes in ahead of the
+    // integrators, and the second one holds on to DC whichever output is picked, so even the high pass keeps
+    // its state out of denormals, and the offset costs one add per sample where the noise needs a generator.
+    FeedbackGuard guard;
     double hostSampleRate{ 0.0f };
-};
\ No newline at end of file
+
+    // The last cutoff and resonance, kept for working out the tail.
+    float currentFrequency{ 1000.0f };
+    float currentResonance{ 1.0f / juce::MathConstants<float>::sqrt2 };
+};
@@ -11,8 +11,23 @@
 
 //==============================================================================
 SimpleFilterAudioProcessorEditor::SimpleFilterAudioProcessorEditor (SimpleFilterAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p), analyzer (p.getAnalyzerSource()),
+      responseCurve (p, p.getAPVTS())
 {
+    cutoffAttach = std::make_unique<Attach>(audioProcessor.getAPVTS(), "CUTOFF", cutoffSlider);
+    resonanceAttach = std::make_unique<Attach>(audioProcessor.getAPVTS(), "RES", resonanceSlider);
+
+    setupSlider(cutoffSlider);
+    setupSlider(resonanceSlider);
+
+    // The combo box has to have its items before the attachment is made so it can pick the right one.
+    typeBox.addItemList(audioProcessor.getAPVTS().getParameter("TYPE")->getAllValueStrings(), 1);
+    typeAttach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.getAPVTS(), "TYPE", typeBox);
+    addAndMakeVisible(typeBox);
+
+    addAndMakeVisible(analyzer);
+    addAndMakeVisible(responseCurve);
+
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
     setSize (400, 300);
@@ -27,14 +42,24 @@ void SimpleFilterAudioProcessorEditor::paint (juce::Graphics& g)
 {
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::white);
-    g.setFont (15.0f);
-    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
 }
 
 void SimpleFilterAudioProcessorEditor::resized()
 {
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
+    auto bounds = getLocalBounds();
+
+    // The analyzer takes the top two thirds and the controls share what is left.
+    analyzer.setBounds(bounds.removeFromTop(bounds.getHeight() * 2 / 3).reduced(5));
+    responseCurve.setBounds(analyzer.getBounds());
+
+    cutoffSlider.setBounds(bounds.getProportion(juce::Rectangle<float>(0.0f, 0.0f, 0.35f, 1.0f)));
+    resonanceSlider.setBounds(bounds.getProportion(juce::Rectangle<float>(0.35f, 0.0f, 0.35f, 1.0f)));
+    typeBox.setBounds(bounds.getProportion(juce::Rectangle<float>(0.7f, 0.0f, 0.3f, 1.0f)).withSizeKeepingCentre(100, 24));
+}
+
+void SimpleFilterAudioProcessorEditor::setupSlider(juce::Slider& slider)
+{
+    slider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+    slider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+    addAndMakeVisible(slider);
 }
@@ -10,6 +10,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "UI/ResponseCurve.h"
 
 //==============================================================================
 /**
@@ -24,10 +25,29 @@ public:
     void paint (juce::Graphics&) override;
     void resized() override;
 
+    void setupSlider(juce::Slider& slider);
+
 private:
+    using Attach = juce::AudioProcessorValueTreeState::SliderAttachment;
+
+    juce::Slider cutoffSlider;
+    juce::Slider resonanceSlider;
+
+    std::unique_ptr<Attach> cutoffAttach;
+    std::unique_ptr<Attach> resonanceAttach;
+
+    juce::ComboBox typeBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> typeAttach;
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     SimpleFilterAudioProcessor& audioProcessor;
 
+    // Shows the spectrum of the output above the sliders.
+    SpectrumAnalyzer analyzer;
+
+    // The filter's own response, drawn over the analyzer with the same frequency axis.
+    ResponseCurve responseCurve;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleFilterAudioProcessorEditor)
 };
@@ -22,6 +22,8 @@ SimpleFilterAudioProcessor::SimpleFilterAudioProcessor()
                        ), apvts(*this, nullptr, "PARAMETERS", createParams())
 #endif
 {
+    // Controller 20 onwards drive the parameters in the order they were added, skipping any the MIDI spec defines.
+    scheduler.mapControllers(getParameters(), firstMappedController, &apvts);
 }
 
 SimpleFilterAudioProcessor::~SimpleFilterAudioProcessor()
@@ -63,43 +65,53 @@ bool SimpleFilterAudioProcessor::isMidiEffect() const
 
 double SimpleFilterAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return silence.getTailLengthSeconds();
 }
 
 int SimpleFilterAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if you're not really implementing programs.
+    return juce::jmax(1, presets.getNumPresets());
 }
 
 int SimpleFilterAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presets.getCurrentPreset();
 }
 
 void SimpleFilterAudioProcessor::setCurrentProgram (int index)
 {
+    // Only queues the preset, the audio thread switches over to it at the next block.
+    presets.selectPreset(index);
 }
 
 const juce::String SimpleFilterAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presets.getPresetName(index);
 }
 
 void SimpleFilterAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    presets.renamePreset(index, newName);
 }
 
 //==============================================================================
 void SimpleFilterAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     filter.prepareToPlay(sampleRate, samplesPerBlock, getNumOutputChannels());
+    silence.setTailLengthSeconds(filter.getTailLengthSeconds());
+    scheduler.prepareToPlay(sampleRate, samplesPerBlock);
+    presets.prepareToPlay(sampleRate);
+    silence.prepareToPlay(sampleRate, samplesPerBlock);
+    analyzerSource.prepareToPlay(sampleRate, samplesPerBlock);
 }
 
 void SimpleFilterAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    presets.releaseResources();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -131,6 +143,95 @@ bool SimpleFilterAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 void SimpleFilterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    const auto isActive = beginBlock(buffer);
+
+    // This is the place where you'd normally do the guts of your plugin's
+    // audio processing...
+    // Make sure to reset the state if your inner loop is processing
+    // the samples and the outer loop is handling the channels.
+    // Alternatively, you can process the samples with the channels
+    // interleaved by keeping the same state.
+
+    auto* cutoffFrequency = apvts.getRawParameterValue("CUTOFF");
+    auto* resonance = apvts.getRawParameterValue("RES");
+    auto* filterType = apvts.getRawParameterValue("TYPE");
+
+    juce::dsp::AudioBlock<float> block{ buffer };
+
+    // The parameters are read again for every segment, so a controller change lands on the right sample.
+    scheduler.process(buffer.getNumSamples(), midiMessages, [&](int startSample, int numSamples)
+    {
+        // Asleep, so the segments only go by to keep the mapped controllers moving.
+        if (! isActive)
+            return;
+
+        filter.updateParameters(cutoffFrequency->load(), resonance->load(), (int)filterType->load());
+
+        // Every channel gets its own filter now, so there is no need to copy the left channel over the right.
+        auto subBlock = block.getSubBlock((size_t)startSample, (size_t)numSamples);
+        filter.process(subBlock);
+    });
+
+    endBlock(buffer);
+}
+
+void SimpleFilterAudioProcessor::processBatch (SimpleFilterAudioProcessor* const* processors, juce::AudioBuffer<float>* const* buffers,
+                                               int numProcessors)
+{
+    if (numProcessors <= 0)
+        return;
+
+    juce::ScopedNoDenormals noDenormals;
+
+    // The filters that are awake go in together a handful at a time, which is plenty to fill the registers
+    // without anything here having to allocate.
+    constexpr int maxGroupSize = 32;
+    FilterData* filters[maxGroupSize];
+    juce::dsp::AudioBlock<float> blocks[maxGroupSize];
+    SimpleFilterAudioProcessor* group[maxGroupSize];
+    const auto numSamples = buffers[0]->getNumSamples();
+
+    for (int start = 0; start < numProcessors; start += maxGroupSize)
+    {
+        const auto end = juce::jmin(numProcessors, start + maxGroupSize);
+        int numFilters = 0;
+
+        for (int i = start; i < end; ++i)
+        {
+            auto& processor = *processors[i];
+            auto& buffer = *buffers[i];
+
+            if (buffer.getNumSamples() != numSamples)
+            {
+                juce::MidiBuffer noMidi;
+                processor.processBlock(buffer, noMidi);
+                continue;
+            }
+
+            group[i - start] = &processor;
+
+            if (! processor.beginBlock(buffer))
+                continue;
+
+            auto& apvts = processor.apvts;
+            processor.filter.updateParameters(apvts.getRawParameterValue("CUTOFF")->load(), apvts.getRawParameterValue("RES")->load(),
+                                              (int)apvts.getRawParameterValue("TYPE")->load());
+
+            filters[numFilters] = &processor.filter;
+            blocks[numFilters] = juce::dsp::AudioBlock<float>{ buffer };
+            ++numFilters;
+        }
+
+        FilterData::processBatch(filters, blocks, numFilters);
+
+        for (int i = start; i < end; ++i)
+            if (buffers[i]->getNumSamples() == numSamples)
+                group[i - start]->endBlock(*buffers[i]);
+    }
+}
+
+bool SimpleFilterAudioProcessor::beginBlock (juce::AudioBuffer<float>& buffer)
+{
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -143,29 +244,38 @@ void SimpleFilterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // This is the place where you'd normally do the guts of your plugin's
-    // audio processing...
-    // Make sure to reset the state if your inner loop is processing
-    // the samples and the outer loop is handling the channels.
-    // Alternatively, you can process the samples with the channels
-    // interleaved by keeping the same state.
+    // Switches to a newly selected preset once the output has faded out for it.
+    presets.beginBlock();
 
-    auto* cutoffFrequency = apvts.getRawParameterValue("CUTOFF");
-    auto* resonance = apvts.getRawParameterValue("RES");
+    // While nothing is coming in or ringing out, the block is left as zeros and the DSP below is skipped.
+    const auto isActive = silence.beginBlock(buffer);
+
+    if (! isActive)
+        buffer.clear();
+
+    return isActive;
+}
 
-    filter.updateParameters(cutoffFrequency->load(), resonance->load());
+void SimpleFilterAudioProcessor::endBlock (juce::AudioBuffer<float>& buffer)
+{
+    // The filter rings for longer the higher the resonance, so the tail follows the parameters.
+    // When it falls asleep the filter is cleared, so it wakes up from nothing.
+    silence.setTailLengthSeconds(filter.getTailLengthSeconds());
+
+    if (silence.endBlock(buffer))
+        filter.reset();
+
+    // Fades out ahead of a queued preset, or back in after one was applied.
+    presets.endBlock(buffer);
 
-    //juce::AudioBuffer<float> audioBuff{ buffer };
-    filter.process(buffer);
-    //buffer.addFrom(channel, 0, audioBuff, 0, 0, audioBuff.getNumSamples());
-    buffer.copyFrom(1, 0, buffer, 0, 0, buffer.getNumSamples());
-        // ..do something to the data...
+    // Only a copy into a FIFO, the analysis itself happens on the editor's thread.
+    analyzerSource.push(buffer);
 }
 
 //==============================================================================
 bool SimpleFilterAudioProcessor::hasEditor() const
 {
-    return false; // (change this to false if you choose to not supply an editor)
+    return true; // (change this to false if you choose to not supply an editor)
 }
 
 juce::AudioProcessorEditor* SimpleFilterAudioProcessor::createEditor()
@@ -179,12 +289,18 @@ void SimpleFilterAudioProcessor::getStateInformation (juce::MemoryBlock& destDat
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
+
+    // Writes every parameter into a small binary blob which is much quicker to load than XML.
+    StateSerializer::save(*this, destData);
 }
 
 void SimpleFilterAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
+
+    // Reads the binary blob back, or the old XML state if that is what the session holds.
+    StateSerializer::load(*this, data, sizeInBytes);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleFilterAudioProcessor::createParams()
@@ -193,6 +309,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleFilterAudioProcessor::
 
     layout.add(std::make_unique<juce::AudioParameterFloat>("CUTOFF", "Cutoff", 20.0f, 20000.0f, 500.0f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("RES", "Resonance", 1.0f, 10.0f, 2.5f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("TYPE", "Type", juce::StringArray{ "Low Pass", "Band Pass", "High Pass" }, 0));
 
     return layout;
 }
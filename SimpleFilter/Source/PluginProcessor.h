@@ -10,6 +10,11 @@
 
 #include <JuceHeader.h>
 #include "Data/FilterData.h"
+#include "../../Shared/SubBlockScheduler.h"
+#include "../../Shared/StateSerializer.h"
+#include "../../Shared/PresetBank.h"
+#include "../../Shared/SilenceDetector.h"
+#include "../../Shared/SpectrumAnalyzer.h"
 
 //==============================================================================
 /**
@@ -34,6 +39,12 @@ public:
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
+    // For a host that runs a lot of these side by side. Does what processBlock does for every processor, except the
+    // filters of all of them go through FilterData::processBatch together. There is no MIDI, so the parameters are
+    // read once for the whole block, and for blocks no longer than prepareToPlay was given the output is exactly
+    // what processBlock would have made. A buffer that isn't the same length as the first goes through processBlock.
+    static void processBatch (SimpleFilterAudioProcessor* const* processors, juce::AudioBuffer<float>* const* buffers, int numProcessors);
+
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -57,6 +68,14 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
+
+    // The editor's spectrum analyzer reads the output from here.
+    AnalyzerSource& getAnalyzerSource() { return analyzerSource; }
+
+    // Everything this instance holds for its DSP, for keeping an eye on memory with a lot of instances open.
+    size_t getDspFootprintBytes() const { return sizeof(*this) + filter.getFootprintBytes() + analyzerSource.getFootprintBytes(); }
+
 private:
     //juce::dsp::StateVariableFilter::Filter<float> filter;
 
@@ -64,6 +83,32 @@ private:
     juce::AudioProcessorValueTreeState::ParameterLayout createParams();
 
     FilterData filter;
+
+    // The parts of processBlock either side of the filter. beginBlock returns false when the block is silent
+    // and the filter can be skipped.
+    bool beginBlock(juce::AudioBuffer<float>& buffer);
+    void endBlock(juce::AudioBuffer<float>& buffer);
+
+    // Splits each block up at its MIDI events.
+    SubBlockScheduler scheduler;
+
+    // The first MIDI controller that is mapped to a parameter. 20 to 31 are undefined in the MIDI spec, once
+    // they run out the scheduler carries on from the next undefined one, 85.
+    static constexpr int firstMappedController{ 20 };
+
+    // Every preset as a snapshot of parameter values, switched over without locking.
+    PresetBank presets{ *this, &apvts };
+
+    // Skips the DSP while the input and anything left ringing out are both silent.
+    SilenceDetector silence;
+
+    // The output handed over to the spectrum analyzer.
+    AnalyzerSource analyzerSource;
+
+    // The editor's analyzer runs on the shared worker pool. Holding on to it here keeps the pool going while the
+    // plugin is loaded, rather than it starting and stopping every time the editor opens and closes.
+    juce::SharedResourcePointer<WorkerPool> workerPool;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleFilterAudioProcessor)
 };
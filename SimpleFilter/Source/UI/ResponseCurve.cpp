@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+    Created: 18 Oct 2026 5:21:47pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+#include "../Data/FilterData.h"
+
+ResponseCurve::ResponseCurve(juce::AudioProcessor& p, juce::AudioProcessorValueTreeState& state)
+    : processor(p), apvts(state)
+{
+    // The curve sits on top of the analyzer, so clicks should go through to whatever is underneath.
+    setInterceptsMouseClicks(false, false);
+
+    for (auto* id : { "CUTOFF", "RES", "TYPE" })
+        apvts.getParameter(id)->addListener(this);
+
+    startTimerHz(30);
+}
+
+ResponseCurve::~ResponseCurve()
+{
+    for (auto* id : { "CUTOFF", "RES", "TYPE" })
+        apvts.getParameter(id)->removeListener(this);
+}
+
+void ResponseCurve::paint(juce::Graphics& g)
+{
+    g.setColour(juce::Colours::orange);
+    g.strokePath(curve, juce::PathStrokeType(2.0f));
+}
+
+void ResponseCurve::resized()
+{
+    needsUpdate = true;
+}
+
+void ResponseCurve::parameterValueChanged(int parameterIndex, float newValue)
+{
+    juce::ignoreUnused(parameterIndex, newValue);
+    needsUpdate = true;
+}
+
+void ResponseCurve::timerCallback()
+{
+    // The sample rate isn't known until the host prepares the processor, and it can change later on.
+    auto sampleRate = processor.getSampleRate();
+
+    if (sampleRate <= 0.0)
+        sampleRate = 44100.0;
+
+    if (sampleRate != tableSampleRate)
+    {
+        updateFrequencyTable(sampleRate);
+        needsUpdate = true;
+    }
+
+    if (needsUpdate.exchange(false))
+    {
+        updateCurve();
+        repaint();
+    }
+}
+
+void ResponseCurve::updateFrequencyTable(double sampleRate)
+{
+    tableSampleRate = sampleRate;
+    numUsablePoints = 0;
+
+    const auto nyquist = (float)sampleRate * 0.5f;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto frequency = juce::mapToLog10((float)i / (float)(numPoints - 1), minimumFrequency, maximumFrequency);
+
+        // tan() heads off to infinity at Nyquist, so the table stops just short of it.
+        if (frequency >= nyquist * 0.999f)
+            break;
+
+        frequencies[(size_t)i] = frequency;
+        warpedFrequencies[(size_t)i] = (float)std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+        ++numUsablePoints;
+    }
+}
+
+void ResponseCurve::updateCurve()
+{
+    curve.clear();
+
+    if (getWidth() <= 0 || getHeight() <= 0 || numUsablePoints == 0)
+        return;
+
+    const auto cutoff = apvts.getRawParameterValue("CUTOFF")->load();
+    const auto resonance = apvts.getRawParameterValue("RES")->load();
+    const auto type = (int)apvts.getRawParameterValue("TYPE")->load();
+
+    FilterData::getMagnitudeResponse(type, cutoff, resonance, tableSampleRate,
+                                     warpedFrequencies.data(), magnitudes.data(), numUsablePoints);
+
+    const auto width = (float)getWidth();
+    const auto height = (float)getHeight();
+
+    for (int i = 0; i < numUsablePoints; ++i)
+    {
+        const auto x = juce::mapFromLog10(frequencies[(size_t)i], minimumFrequency, maximumFrequency) * width;
+        const auto decibels = juce::jlimit(minimumDecibels, maximumDecibels, juce::Decibels::gainToDecibels(magnitudes[(size_t)i], minimumDecibels));
+        const auto y = juce::jmap(decibels, minimumDecibels, maximumDecibels, height, 0.0f);
+
+        if (i == 0)
+            curve.startNewSubPath(x, y);
+        else
+            curve.lineTo(x, y);
+    }
+}
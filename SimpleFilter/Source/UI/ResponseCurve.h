@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+    Created: 18 Oct 2026 5:21:47pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Draws the frequency response of the filter over the spectrum analyzer. The curve is only worked out
+// again when CUTOFF, RES or TYPE change, every other repaint just strokes the cached path.
+class ResponseCurve : public juce::Component,
+                      private juce::AudioProcessorParameter::Listener,
+                      private juce::Timer
+{
+public:
+    ResponseCurve(juce::AudioProcessor& processor, juce::AudioProcessorValueTreeState& apvts);
+    ~ResponseCurve() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    // Listens to the parameters rather than the value tree, which doesn't hear about MIDI controller changes.
+    // Can be called from any thread, so it only marks the curve as out of date.
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+    void timerCallback() override;
+
+    // Fills the log spaced frequency table and its prewarped values for the given sample rate.
+    void updateFrequencyTable(double sampleRate);
+
+    // Evaluates the filter at every point in the table and rebuilds the path.
+    void updateCurve();
+
+    juce::AudioProcessor& processor;
+    juce::AudioProcessorValueTreeState& apvts;
+
+    static constexpr int numPoints{ 256 };
+    static constexpr float minimumFrequency{ 20.0f };
+    static constexpr float maximumFrequency{ 20000.0f };
+    static constexpr float minimumDecibels{ -48.0f };
+    static constexpr float maximumDecibels{ 24.0f };
+
+    // The frequencies to look at and tan(pi * f / fs) for each of them.
+    std::array<float, numPoints> frequencies;
+    std::array<float, numPoints> warpedFrequencies;
+    std::array<float, numPoints> magnitudes;
+
+    // Frequencies at or above Nyquist are left off the end of the curve.
+    int numUsablePoints{ 0 };
+    double tableSampleRate{ 0.0 };
+
+    juce::Path curve;
+    std::atomic<bool> needsUpdate{ true };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ResponseCurve)
+};
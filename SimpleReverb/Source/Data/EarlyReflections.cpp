@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+    EarlyReflections.cpp
+    Created: 18 Oct 2026 8:52:19pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "EarlyReflections.h"
+
+EarlyReflections::~EarlyReflections()
+{
+    pool->cancelAndWait(task);
+}
+
+int EarlyReflections::getDelayLength(double sampleRate, int samplesPerBlock)
+{
+    return juce::nextPowerOfTwo((int)std::ceil(maxTapSeconds * sampleRate) + samplesPerBlock + 1);
+}
+
+size_t EarlyReflections::getRequiredBytes(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    return DspArena::getBufferSize(numChannels, getDelayLength(sampleRate, samplesPerBlock))
+         + DspArena::getBufferSize(numChannels, samplesPerBlock)
+         + DspArena::getBufferSize(1, samplesPerBlock);
+}
+
+void EarlyReflections::prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels, DspArena& arena)
+{
+    const auto length = getDelayLength(sampleRate, samplesPerBlock);
+    arena.allocateBuffer(delayLine, numChannels, length);
+    delayMask = length - 1;
+
+    arena.allocateBuffer(reflections, numChannels, samplesPerBlock);
+    arena.allocateBuffer(fadeBuffer, 1, samplesPerBlock);
+    reset();
+
+    // Nothing is playing yet, so the first set of taps can be worked out right here.
+    computeTaps(tapSets[(size_t)readSlot], (Room)requestedRoom.load(), requestedSize.load(), sampleRate);
+
+    // The worker pool picks the new sample rate up and keeps the taps in step with the room from now on.
+    requestedSampleRate = sampleRate;
+
+    if (task == nullptr)
+        task = pool->submitRepeating([this](const WorkerPool::Task&) { updateTaps(); }, 50);
+}
+
+void EarlyReflections::reset()
+{
+    delayLine.clear();
+    reflections.clear();
+    writePosition = 0;
+    renderedSamples = 0;
+}
+
+void EarlyReflections::setRoom(const Room newRoom, const float newSize)
+{
+    requestedRoom = (int)newRoom;
+    requestedSize = newSize;
+}
+
+void EarlyReflections::render(const juce::dsp::AudioBlock<float>& input)
+{
+    const auto numSamples = (int)input.getNumSamples();
+    const auto numChannels = juce::jmin((int)input.getNumChannels(), delayLine.getNumChannels());
+    const auto length = delayMask + 1;
+
+    jassert(numSamples <= reflections.getNumSamples());
+
+    // Take the new taps if the worker pool has left some, and fade over to them from the old ones.
+    const auto isFading = (middleSlot.load() & dirtyBit) != 0;
+
+    if (isFading)
+    {
+        fadingTaps = tapSets[(size_t)readSlot];
+        readSlot = middleSlot.exchange(readSlot) & ~dirtyBit;
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        // Write the whole block in first so the shortest taps can read from it straight away.
+        const auto* source = input.getChannelPointer((size_t)channel);
+        const auto firstPart = juce::jmin(numSamples, length - writePosition);
+        delayLine.copyFrom(channel, writePosition, source, firstPart);
+
+        if (firstPart < numSamples)
+            delayLine.copyFrom(channel, 0, source + firstPart, numSamples - firstPart);
+
+        auto* destination = reflections.getWritePointer(channel);
+        juce::FloatVectorOperations::clear(destination, numSamples);
+        renderTaps(tapSets[(size_t)readSlot], channel, destination, numSamples, writePosition);
+
+        if (isFading)
+        {
+            auto* faded = fadeBuffer.getWritePointer(0);
+            juce::FloatVectorOperations::clear(faded, numSamples);
+            renderTaps(fadingTaps, channel, faded, numSamples, writePosition);
+
+            for (int sample = 0; sample < numSamples; ++sample)
+                destination[sample] = faded[sample] + (destination[sample] - faded[sample]) * (float)sample / (float)numSamples;
+        }
+    }
+
+    writePosition = (writePosition + numSamples) & delayMask;
+    renderedSamples = numSamples;
+}
+
+void EarlyReflections::addTo(juce::dsp::AudioBlock<float>& output) const
+{
+    const auto numChannels = juce::jmin((int)output.getNumChannels(), reflections.getNumChannels());
+    const auto numSamples = juce::jmin((int)output.getNumSamples(), renderedSamples);
+
+    if (level <= 0.0f)
+        return;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        SimdKernels::get().addWithMultiply(output.getChannelPointer((size_t)channel), reflections.getReadPointer(channel), numSamples, level);
+}
+
+size_t EarlyReflections::getFootprintBytes() const
+{
+    return DspArena::getBufferSize(delayLine.getNumChannels(), delayLine.getNumSamples())
+         + DspArena::getBufferSize(reflections.getNumChannels(), reflections.getNumSamples())
+         + DspArena::getBufferSize(fadeBuffer.getNumChannels(), fadeBuffer.getNumSamples())
+         + sizeof(tapSets) + sizeof(fadingTaps);
+}
+
+void EarlyReflections::renderTaps(const TapSet& taps, int channel, float* destination, int numSamples, int startPosition) const
+{
+    const auto* data = delayLine.getReadPointer(channel);
+    const auto length = delayMask + 1;
+
+    // Two channels share one set of taps for the ears, anything past the second uses the second.
+    const auto ear = (size_t)juce::jmin(channel, 1);
+    const auto& kernels = SimdKernels::get();
+
+    // Each tap is a delayed copy of the whole block, so it comes down to one multiply-add over a run of memory.
+    for (int tap = 0; tap < taps.numTaps; ++tap)
+    {
+        const auto delay = taps.delays[ear][(size_t)tap];
+
+        // A set worked out for a higher sample rate can reach further back than the delay line holds, so skip those.
+        if (delay > length - numSamples)
+            continue;
+
+        const auto gain = taps.gains[ear][(size_t)tap];
+        const auto readPosition = (startPosition - delay) & delayMask;
+        const auto firstPart = juce::jmin(numSamples, length - readPosition);
+
+        kernels.addWithMultiply(destination, data + readPosition, firstPart, gain);
+
+        if (firstPart < numSamples)
+            kernels.addWithMultiply(destination + firstPart, data, numSamples - firstPart, gain);
+    }
+}
+
+void EarlyReflections::updateTaps()
+{
+    const auto room = requestedRoom.load();
+    const auto size = requestedSize.load();
+    const auto sampleRate = requestedSampleRate.load();
+
+    if (sampleRate <= 0.0 || (room == computedRoom && size == computedSize && sampleRate == computedSampleRate))
+        return;
+
+    computeTaps(tapSets[(size_t)writeSlot], (Room)room, size, sampleRate);
+    computedRoom = room;
+    computedSize = size;
+    computedSampleRate = sampleRate;
+
+    // Hand the new set over and take back whatever was waiting in the middle.
+    writeSlot = middleSlot.exchange(writeSlot | dirtyBit) & ~dirtyBit;
+}
+
+void EarlyReflections::computeTaps(TapSet& taps, const Room room, const float size, const double sampleRate)
+{
+    struct Dimensions { float width, depth, height, reflectivity; };
+
+    // Width, depth and height in metres, and how much of the sound each wall sends back.
+    static constexpr Dimensions rooms[]{ { 2.5f, 2.0f, 2.2f, 0.5f },
+                                         { 5.0f, 4.0f, 2.8f, 0.7f },
+                                         { 9.0f, 7.0f, 3.5f, 0.75f },
+                                         { 25.0f, 18.0f, 10.0f, 0.85f } };
+
+    const auto& dimensions = rooms[juce::jlimit(0, 3, (int)room)];
+    const auto scale = 0.5f + juce::jlimit(0.0f, 1.0f, size);
+    const juce::Vector3D<float> roomSize{ dimensions.width * scale, dimensions.depth * scale, dimensions.height * scale };
+
+    // The source is off to one side near the back, and the listener's ears are either side of a point near the front.
+    const juce::Vector3D<float> source{ roomSize.x * 0.62f, roomSize.y * 0.7f, juce::jmin(1.4f, roomSize.z * 0.5f) };
+    const juce::Vector3D<float> listener{ roomSize.x * 0.45f, roomSize.y * 0.3f, source.z };
+    const juce::Vector3D<float> ears[]{ listener - juce::Vector3D<float>{ 0.09f, 0.0f, 0.0f }, listener + juce::Vector3D<float>{ 0.09f, 0.0f, 0.0f } };
+
+    // Reflecting off the walls n times along an axis puts the image of the source at n room lengths along,
+    // mirrored every other time.
+    auto image = [](int n, float position, float length)
+    {
+        return (float)n * length + ((n & 1) == 0 ? position : length - position);
+    };
+
+    constexpr auto speedOfSound = 343.0f;
+    constexpr auto maxOrder = 3;
+
+    std::vector<std::pair<float, float>> candidates;
+    candidates.reserve(64);
+
+    int numTaps = maxTaps;
+
+    for (size_t ear = 0; ear < 2; ++ear)
+    {
+        candidates.clear();
+        const auto directDistance = (source - ears[ear]).length();
+
+        for (int x = -maxOrder; x <= maxOrder; ++x)
+        {
+            for (int y = -maxOrder; y <= maxOrder; ++y)
+            {
+                for (int z = -maxOrder; z <= maxOrder; ++z)
+                {
+                    const auto order = std::abs(x) + std::abs(y) + std::abs(z);
+
+                    if (order == 0 || order > maxOrder)
+                        continue;
+
+                    const juce::Vector3D<float> position{ image(x, source.x, roomSize.x), image(y, source.y, roomSize.y), image(z, source.z, roomSize.z) };
+                    const auto distance = (position - ears[ear]).length();
+
+                    // The dry signal is the direct sound, so each reflection is delayed by how much further it travelled.
+                    const auto delaySeconds = (distance - directDistance) / speedOfSound;
+
+                    if (delaySeconds <= 0.0f || delaySeconds > maxTapSeconds)
+                        continue;
+
+                    // Every bounce takes some away, and it spreads out over the extra distance as well.
+                    const auto gain = std::pow(dimensions.reflectivity, (float)order) * directDistance / distance;
+                    candidates.emplace_back(delaySeconds, gain);
+                }
+            }
+        }
+
+        // Earliest first, which is also the order they are read back in.
+        std::sort(candidates.begin(), candidates.end());
+        numTaps = juce::jmin(numTaps, (int)candidates.size());
+
+        for (int tap = 0; tap < juce::jmin(maxTaps, (int)candidates.size()); ++tap)
+        {
+            taps.delays[ear][(size_t)tap] = juce::jmax(1, juce::roundToInt(candidates[(size_t)tap].first * sampleRate));
+            taps.gains[ear][(size_t)tap] = candidates[(size_t)tap].second;
+        }
+    }
+
+    taps.numTaps = numTaps;
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    EarlyReflections.h
+    Created: 18 Oct 2026 8:52:19pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../../Shared/DspArena.h"
+#include "../../../Shared/WorkerPool.h"
+#include "../../../Shared/SimdKernels.h"
+
+// The first few dozen echoes off the walls, floor and ceiling of a shoebox shaped room, worked out with the image
+// source model. The taps are computed on the shared worker pool whenever the room changes and handed over without
+// locking, so the audio thread only ever adds delayed copies of the input together.
+class EarlyReflections
+{
+public:
+    static constexpr int maxTaps{ 48 };
+    static constexpr float maxTapSeconds{ 0.15f };
+
+    enum class Room { booth, room, studio, hall };
+
+    EarlyReflections() = default;
+    ~EarlyReflections();
+
+    // What prepareToPlay() takes from the arena.
+    static size_t getRequiredBytes(double sampleRate, int samplesPerBlock, int numChannels);
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels, DspArena& arena);
+    void reset();
+
+    // Safe to call from the audio thread, it only notes the room down for the worker pool to pick up.
+    void setRoom(const Room newRoom, const float newSize);
+    void setLevel(const float newLevel) { level = newLevel; }
+
+    // Writes the input into the delay line and works out the reflections for it. This has to happen before
+    // anything else changes the block, addTo() then mixes them in wherever they should go.
+    void render(const juce::dsp::AudioBlock<float>& input);
+    void addTo(juce::dsp::AudioBlock<float>& output) const;
+
+    // The delay line and render buffers in the arena, plus the tap sets.
+    size_t getFootprintBytes() const;
+
+private:
+    // One set of taps for each ear, both sorted by delay so the reads walk forwards through the delay line.
+    struct TapSet
+    {
+        int numTaps{ 0 };
+        std::array<std::array<int, maxTaps>, 2> delays{};
+        std::array<std::array<float, maxTaps>, 2> gains{};
+    };
+
+    // Runs on the worker pool every 50ms, and works out a new set of taps when the room has changed.
+    void updateTaps();
+
+    // Long enough for the furthest tap plus a whole block, since the block is written in before any of it is read.
+    static int getDelayLength(double sampleRate, int samplesPerBlock);
+
+    // The image source model, run on the worker pool.
+    static void computeTaps(TapSet& taps, const Room room, const float size, const double sampleRate);
+
+    // Adds every tap in the set into the destination, scaled by gain.
+    void renderTaps(const TapSet& taps, int channel, float* destination, int numSamples, int startPosition) const;
+
+    // The input for each channel, a power of two long so the positions just need masking.
+    juce::AudioBuffer<float> delayLine;
+    int delayMask{ 0 };
+    int writePosition{ 0 };
+
+    // The reflections for the current block, and room to render the old taps into while crossfading.
+    juce::AudioBuffer<float> reflections;
+    juce::AudioBuffer<float> fadeBuffer;
+    int renderedSamples{ 0 };
+
+    // A triple buffer. The worker pool fills in its slot and swaps it with the middle one, the audio thread
+    // swaps its own slot with the middle whenever the dirty bit says there is something new waiting there.
+    std::array<TapSet, 3> tapSets;
+
+    // A copy of the taps being faded out of, the slot they came from goes back to the worker pool straight away.
+    TapSet fadingTaps;
+    std::atomic<int> middleSlot{ 1 };
+    int readSlot{ 0 };
+    int writeSlot{ 2 };
+    static constexpr int dirtyBit{ 4 };
+
+    // What the audio thread has asked for, and what the worker pool last worked out.
+    std::atomic<int> requestedRoom{ (int)Room::room };
+    std::atomic<float> requestedSize{ 0.5f };
+    std::atomic<double> requestedSampleRate{ 0.0 };
+    int computedRoom{ -1 };
+    float computedSize{ -1.0f };
+    double computedSampleRate{ 0.0 };
+
+    float level{ 0.0f };
+
+    juce::SharedResourcePointer<WorkerPool> pool;
+    WorkerPool::TaskPtr task;
+};
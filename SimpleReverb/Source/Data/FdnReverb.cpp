@@ -0,0 +1,311 @@
+/*
+  ==============================================================================
+
+    FdnReverb.cpp
+    Created: 18 Oct 2026 8:05:52pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "FdnReverb.h"
+
+size_t FdnReverb::getRequiredBytes(double sampleRate)
+{
+    return DspArena::getAlignedSize((size_t)(getLineSize(sampleRate) * maxLines) * sizeof(float));
+}
+
+int FdnReverb::getLineSize(double sampleRate)
+{
+    // The longest line, plus the modulation either side and a sample for the interpolation, rounded up to a power of two.
+    const auto longest = (int)(97.0 * 0.001 * sampleRate) | 1;
+    const auto modulation = 2.0 * 0.00025 * sampleRate;
+    return juce::nextPowerOfTwo((int)std::ceil(longest + modulation) + 2);
+}
+
+void FdnReverb::prepareToPlay(double sampleRate, int samplesPerBlock, DspArena& arena)
+{
+    juce::ignoreUnused(samplesPerBlock);
+    hostSampleRate = sampleRate;
+
+    // The lines are spread out exponentially between 23ms and 97ms and made odd, so they don't share many
+    // factors and their echoes don't all line up with each other.
+    for (int line = 0; line < maxLines; ++line)
+    {
+        const auto milliseconds = 23.0 * std::pow(97.0 / 23.0, (double)line / (double)(maxLines - 1));
+        baseDelays[(size_t)line] = (float)((int)(milliseconds * 0.001 * sampleRate) | 1);
+
+        // Every line wobbles at its own slow rate so the modulation doesn't pulse.
+        modulationRates[(size_t)line] = juce::MathConstants<float>::twoPi * (0.1f + 0.05f * (float)line) / (float)sampleRate;
+        modulationPhases[(size_t)line] = (float)line * 0.7f;
+    }
+
+    modulationDepth = (float)(0.00025 * sampleRate);
+
+    lineSize = getLineSize(sampleRate);
+    lineMask = lineSize - 1;
+
+    // Every line in one piece of the arena, one after the other.
+    delayMemory = arena.allocate<float>((size_t)(lineSize * maxLines), delayFallback);
+
+    reset();
+    updateGains();
+
+    isPrepared = true;
+}
+
+void FdnReverb::reset()
+{
+    if (delayMemory != nullptr)
+        juce::FloatVectorOperations::clear(delayMemory, lineSize * maxLines);
+
+    for (auto& state : lowpassStates)
+        state = Lanes::expand(0.0f);
+
+    writePosition = 0;
+
+    for (size_t line = 0; line < (size_t)maxLines; ++line)
+        currentDelays[line] = baseDelays[line] * roomScale + modulationDepth;
+}
+
+void FdnReverb::setNumLines(const int newNumLines)
+{
+    const auto lines = newNumLines > 8 ? 16 : 8;
+
+    if (lines != numLines)
+    {
+        numLines = lines;
+        updateGains();
+    }
+}
+
+void FdnReverb::setParameters(const juce::dsp::Reverb::Parameters& newParameters)
+{
+    parameters = newParameters;
+
+    // Room size sets both how long the tail lasts and how big the room sounds.
+    rt60 = 0.3f + 8.0f * parameters.roomSize * parameters.roomSize;
+    roomScale = 0.5f + 0.5f * parameters.roomSize;
+
+    updateGains();
+}
+
+double FdnReverb::getTailLengthSeconds() const
+{
+    if (parameters.freezeMode >= 0.5f)
+        return std::numeric_limits<double>::infinity();
+
+    // RT60 is the time to fall by 60dB, so twice that gets down to -120dB.
+    return 2.0 * rt60;
+}
+
+void FdnReverb::updateGains()
+{
+    const auto isFrozen = parameters.freezeMode >= 0.5f;
+
+    alignas(Lanes::SIMDRegisterSize) float decay[maxLines];
+    alignas(Lanes::SIMDRegisterSize) float input[maxLines];
+    alignas(Lanes::SIMDRegisterSize) float left[maxLines];
+    alignas(Lanes::SIMDRegisterSize) float right[maxLines];
+
+    const auto scale = 1.0f / std::sqrt((float)numLines);
+
+    for (int line = 0; line < maxLines; ++line)
+    {
+        const auto isUsed = line < numLines;
+
+        // Longer lines go round less often, so they lose more each trip to keep every line decaying at the same rate.
+        const auto delaySeconds = baseDelays[(size_t)line] * roomScale / (float)hostSampleRate;
+        decay[line] = isFrozen ? 1.0f : std::pow(10.0f, -3.0f * delaySeconds / rt60);
+
+        // Alternating signs into and out of the lines keeps the two outputs different from each other.
+        input[line] = isUsed && ! isFrozen ? ((line & 1) == 0 ? scale : -scale) : 0.0f;
+        left[line] = isUsed ? ((line & 2) == 0 ? scale : -scale) : 0.0f;
+        right[line] = isUsed ? ((line & 1) == 0 ? scale : -scale) : 0.0f;
+    }
+
+    for (int i = 0; i < maxRegisters; ++i)
+    {
+        decayGains[(size_t)i] = Lanes::fromRawArray(decay + i * lanes);
+        inputGains[(size_t)i] = Lanes::fromRawArray(input + i * lanes);
+        leftGains[(size_t)i] = Lanes::fromRawArray(left + i * lanes);
+        rightGains[(size_t)i] = Lanes::fromRawArray(right + i * lanes);
+    }
+
+    // A one pole lowpass in every line, more damping pulls its cutoff down. Frozen it has to pass everything.
+    damping = Lanes::expand(isFrozen ? 1.0f : 1.0f - 0.85f * parameters.damping);
+}
+
+void FdnReverb::mixLines(Lanes* lines) const
+{
+    const auto numRegisters = numLines / lanes;
+
+    // Householder inside each register: take 2/N of the sum away from every lane.
+    const auto reflection = 2.0f / (float)lanes;
+
+    for (int i = 0; i < numRegisters; ++i)
+        lines[i] = lines[i] - Lanes::expand(reflection * lines[i].sum());
+
+    // Hadamard across the registers, as butterflies on whole registers.
+    for (int half = 1; half < numRegisters; half *= 2)
+    {
+        for (int start = 0; start < numRegisters; start += half * 2)
+        {
+            for (int i = start; i < start + half; ++i)
+            {
+                const auto a = lines[i];
+                const auto b = lines[i + half];
+                lines[i] = a + b;
+                lines[i + half] = a - b;
+            }
+        }
+    }
+
+    if (numRegisters > 1)
+    {
+        const auto normalise = Lanes::expand(1.0f / std::sqrt((float)numRegisters));
+
+        for (int i = 0; i < numRegisters; ++i)
+            lines[i] = lines[i] * normalise;
+    }
+}
+
+void FdnReverb::process(juce::dsp::AudioBlock<float>& block)
+{
+    jassert(isPrepared);
+
+    const auto numSamples = (int)block.getNumSamples();
+    const auto numChannels = (int)block.getNumChannels();
+
+    if (numSamples == 0 || numChannels == 0)
+        return;
+
+    auto* left = block.getChannelPointer(0);
+    auto* right = numChannels > 1 ? block.getChannelPointer(1) : nullptr;
+
+    // The delays glide from where they were to where they should be by the end of the block, which covers
+    // both the modulation and the room size changing without any jumps.
+    std::array<float, maxLines> delaySteps{};
+
+    for (size_t line = 0; line < (size_t)numLines; ++line)
+    {
+        modulationPhases[line] += modulationRates[line] * (float)numSamples;
+
+        if (modulationPhases[line] > juce::MathConstants<float>::twoPi)
+            modulationPhases[line] -= juce::MathConstants<float>::twoPi;
+
+        const auto target = baseDelays[line] * roomScale + modulationDepth * (1.0f + std::sin(modulationPhases[line]));
+        delaySteps[line] = (target - currentDelays[line]) / (float)numSamples;
+    }
+
+    // The variant is picked once for the whole block.
+    const auto isFrozen = parameters.freezeMode >= 0.5f;
+
+    if (right != nullptr)
+    {
+        if (isFrozen)
+            processSamples<true, true>(left, right, numSamples, delaySteps);
+        else
+            processSamples<true, false>(left, right, numSamples, delaySteps);
+    }
+    else
+    {
+        if (isFrozen)
+            processSamples<false, true>(left, right, numSamples, delaySteps);
+        else
+            processSamples<false, false>(left, right, numSamples, delaySteps);
+    }
+
+    for (size_t line = 0; line < (size_t)numLines; ++line)
+        currentDelays[line] += delaySteps[line] * (float)numSamples;
+}
+
+template <bool isStereo, bool isFrozen>
+void FdnReverb::processSamples(float* left, float* right, int numSamples, const std::array<float, maxLines>& delaySteps)
+{
+    const auto numRegisters = numLines / lanes;
+
+    // Same wet and dry scaling as juce::dsp::Reverb so switching engines doesn't jump in level.
+    const auto wet = parameters.wetLevel * 3.0f;
+    const auto dryGain = parameters.dryLevel * 2.0f;
+    const auto wetGain1 = 0.5f * wet * (1.0f + parameters.width);
+    const auto wetGain2 = 0.5f * wet * (1.0f - parameters.width);
+
+    alignas(Lanes::SIMDRegisterSize) float delayed[maxLines];
+    alignas(Lanes::SIMDRegisterSize) float feedback[maxLines];
+    Lanes lines[maxRegisters];
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        const auto input = isStereo ? 0.5f * (left[sample] + right[sample]) : left[sample];
+
+        // Read every line with linear interpolation, there is no gather so this part is a lane at a time.
+        for (int line = 0; line < numLines; ++line)
+        {
+            const auto delay = currentDelays[(size_t)line] + delaySteps[(size_t)line] * (float)sample;
+            const auto whole = (int)delay;
+            const auto fraction = delay - (float)whole;
+
+            const auto* data = delayMemory + line * lineSize;
+            const auto newer = data[(writePosition - whole) & lineMask];
+            const auto older = data[(writePosition - whole - 1) & lineMask];
+
+            delayed[line] = newer + (older - newer) * fraction;
+        }
+
+        auto leftSum = Lanes::expand(0.0f);
+        auto rightSum = Lanes::expand(0.0f);
+
+        for (int i = 0; i < numRegisters; ++i)
+        {
+            const auto output = Lanes::fromRawArray(delayed + i * lanes);
+            leftSum = leftSum + output * leftGains[(size_t)i];
+            rightSum = rightSum + output * rightGains[(size_t)i];
+
+            // Damp and decay each line before it goes back round. Frozen, the damping passes everything and the
+            // decay is 1, so the line goes straight back in. The state still follows it for when freeze is let go.
+            if (isFrozen)
+            {
+                lowpassStates[(size_t)i] = output;
+                lines[i] = output;
+            }
+            else
+            {
+                auto& state = lowpassStates[(size_t)i];
+                state = state + (output - state) * damping;
+                lines[i] = state * decayGains[(size_t)i];
+            }
+        }
+
+        mixLines(lines);
+
+        // Nothing new gets in while frozen.
+        for (int i = 0; i < numRegisters; ++i)
+        {
+            if (isFrozen)
+                lines[i].copyToRawArray(feedback + i * lanes);
+            else
+                (lines[i] + inputGains[(size_t)i] * Lanes::expand(input)).copyToRawArray(feedback + i * lanes);
+        }
+
+        for (int line = 0; line < numLines; ++line)
+            delayMemory[line * lineSize + writePosition] = feedback[line];
+
+        writePosition = (writePosition + 1) & lineMask;
+
+        const auto wetLeft = leftSum.sum();
+        const auto wetRight = rightSum.sum();
+
+        if (isStereo)
+        {
+            const auto dryLeft = left[sample];
+            const auto dryRight = right[sample];
+            left[sample] = dryLeft * dryGain + wetLeft * wetGain1 + wetRight * wetGain2;
+            right[sample] = dryRight * dryGain + wetRight * wetGain1 + wetLeft * wetGain2;
+        }
+        else
+        {
+            left[sample] = left[sample] * dryGain + wetLeft * wet;
+        }
+    }
+}
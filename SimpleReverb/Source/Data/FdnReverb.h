@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    FdnReverb.h
+    Created: 18 Oct 2026 8:05:52pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../../Shared/DspArena.h"
+
+// A feedback delay network reverb. Every delay line feeds back into every other one through an orthogonal matrix,
+// which builds up a much denser tail than the separate combs of juce::dsp::Reverb for less work per sample.
+// The lines are handled a SIMDRegister at a time, and all of their memory is one piece of the processor's arena.
+class FdnReverb
+{
+public:
+    static constexpr int maxLines{ 16 };
+
+    // What prepareToPlay() takes from the arena at this sample rate.
+    static size_t getRequiredBytes(double sampleRate);
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock, DspArena& arena);
+    void process(juce::dsp::AudioBlock<float>& block);
+    void reset();
+
+    // 8 or 16 lines, more lines gives a denser tail for a little more work.
+    void setNumLines(const int newNumLines);
+
+    // Uses the same parameters as juce::dsp::Reverb so the two can be swapped without the knobs changing meaning.
+    void setParameters(const juce::dsp::Reverb::Parameters& newParameters);
+
+    // Twice the RT60, which is down to -120dB. Infinite while frozen.
+    double getTailLengthSeconds() const;
+
+    // The memory used by the delay lines.
+    size_t getFootprintBytes() const { return (size_t)(lineSize * maxLines) * sizeof(float); }
+
+private:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static constexpr int lanes{ (int)Lanes::size() };
+    static constexpr int maxRegisters{ maxLines / lanes };
+    static_assert(maxLines % lanes == 0 && (8 % lanes) == 0, "The lines have to fill whole registers");
+
+    // The feedback matrix. A Householder reflection mixes the lanes inside each register, and Hadamard butterflies
+    // mix the registers with each other. Both are orthogonal so no energy is gained or lost going round the loop.
+    void mixLines(Lanes* lines) const;
+
+    // The loop over the samples, built once for each combination so neither choice is made inside it. Mono reads
+    // and writes a single channel, and frozen skips the damping, the decay and the input, which are all no-ops then.
+    template <bool isStereo, bool isFrozen>
+    void processSamples(float* left, float* right, int numSamples, const std::array<float, maxLines>& delaySteps);
+
+    // Works out the decay and damping for each line from the parameters.
+    void updateGains();
+
+    // Every line is the same power of two long, enough for the longest line and its modulation at this sample rate.
+    static int getLineSize(double sampleRate);
+
+    double hostSampleRate{ 44100.0 };
+    int numLines{ 8 };
+
+    // Every line has the same power of two length so one write position and a mask covers them all.
+    // They come out of the arena, or out of delayFallback if it couldn't fit them.
+    float* delayMemory{ nullptr };
+    juce::HeapBlock<char> delayFallback;
+    int lineSize{ 0 };
+    int lineMask{ 0 };
+    int writePosition{ 0 };
+
+    // The delay of each line at full room size, and where each one's modulation has got to.
+    std::array<float, maxLines> baseDelays{};
+    std::array<float, maxLines> currentDelays{};
+    std::array<float, maxLines> modulationPhases{};
+    std::array<float, maxLines> modulationRates{};
+    float modulationDepth{ 0.0f };
+
+    // Per line gains, lined up in registers.
+    std::array<Lanes, maxRegisters> decayGains;
+    std::array<Lanes, maxRegisters> lowpassStates;
+    std::array<Lanes, maxRegisters> inputGains;
+    std::array<Lanes, maxRegisters> leftGains;
+    std::array<Lanes, maxRegisters> rightGains;
+    Lanes damping;
+
+    juce::dsp::Reverb::Parameters parameters;
+    float rt60{ 2.0f };
+    float roomScale{ 1.0f };
+
+    bool isPrepared{ false };
+};
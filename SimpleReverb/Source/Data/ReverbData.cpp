@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    ReverbData.cpp
+    Created: 18 Oct 2026 10:31:07am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "ReverbData.h"
+
+size_t ReverbData::getRequiredBytes(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    return DspArena::getBufferSize(numChannels, getCircleLength(sampleRate))
+         + FdnReverb::getRequiredBytes(sampleRate)
+         + EarlyReflections::getRequiredBytes(sampleRate, samplesPerBlock, numChannels);
+}
+
+void ReverbData::prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels, DspArena& arena)
+{
+    // Create a ProcessSpec struct to hold the data needed for the reverbs Prepare function
+    juce::dsp::ProcessSpec spec;
+
+    // Define the 3 variables that a ProcessSpec can hold.
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = samplesPerBlock;
+    spec.numChannels = numChannels;
+
+    // Prepare the reverb for play.
+    reverb.prepare(spec);
+    fdn.prepareToPlay(sampleRate, samplesPerBlock, arena);
+    early.prepareToPlay(sampleRate, samplesPerBlock, numChannels, arena);
+
+    setSampleRate = sampleRate;
+
+    // Sets how many samples behind the write head the read head is. Start at its max value
+    readHeadDelaySamples = sampleRate * maxDelayTimeSeconds;
+
+    // Sets the size of the circular buffer. As 2 times the maxDelay length.
+    arena.allocateBuffer(circleBuffer, numChannels, getCircleLength(sampleRate));
+
+    // Clear the contents of the circleBuffer for now
+    circleBuffer.clear();
+    writeHeadSamplePosition = 0;
+
+    maxBlockSize = juce::jmax(1, samplesPerBlock);
+    isPrepared = true;
+}
+
+void ReverbData::process(juce::AudioBuffer<float>& buffer)
+{
+    juce::dsp::AudioBlock<float> block{ buffer };
+    process(block);
+}
+
+void ReverbData::process(juce::dsp::AudioBlock<float>& block)
+{
+    jassert(isPrepared);
+
+    // The early reflections render a block at a time into buffers of maxBlockSize, so anything longer goes in pieces.
+    ReBlocker::forEachChunk(block, maxBlockSize, [this](juce::dsp::AudioBlock<float>& chunk) { processChunk(chunk); });
+}
+
+void ReverbData::processChunk(juce::dsp::AudioBlock<float>& block)
+{
+    // The comb only passes on its own feedback, so the reflections have to be taken from the input before it
+    // and mixed back in after it for the reverb to build on.
+    early.render(block);
+    processComb(block);
+    early.addTo(block);
+
+    // Get the reverb to process the data in this block
+    if (engine == 0)
+        reverb.process(juce::dsp::ProcessContextReplacing<float>{ block });
+    else
+        fdn.process(block);
+
+    if (! FeedbackGuard::isHealthy(block))
+    {
+        reset();
+        block.clear();
+    }
+}
+
+void ReverbData::reset()
+{
+    reverb.reset();
+    fdn.reset();
+    early.reset();
+    circleBuffer.clear();
+    writeHeadSamplePosition = 0;
+}
+
+void ReverbData::updateParameters(const juce::dsp::Reverb::Parameters& reverbParams, const float newMix, const float newDelayLine, const float newFeedback)
+{
+    // Set the reverb params.
+    reverb.setParameters(reverbParams);
+    fdn.setParameters(reverbParams);
+    currentReverbParams = reverbParams;
+
+    mix = newMix;
+    delayLine = newDelayLine;
+
+    // A NaN here would end up in the circle buffer, so anything that isn't a number leaves the feedback as it was.
+    if (std::isfinite(newFeedback))
+        feedback = juce::jlimit(0.0f, 1.0f, newFeedback);
+
+    //readHeadDelaySamples = (int)((float)setSampleRate * delayLine);
+    readHeadDelaySamples = 1000;
+}
+
+void ReverbData::setEngine(const int newEngine)
+{
+    // The engine being switched to has been sat idle, so clear out whatever it had left from last time.
+    if (newEngine != engine)
+    {
+        if (newEngine == 0)
+            reverb.reset();
+        else
+            fdn.reset();
+    }
+
+    engine = newEngine;
+    fdn.setNumLines(engine == 2 ? 16 : 8);
+}
+
+void ReverbData::setEarlyReflections(const EarlyReflections::Room room, const float size, const float level)
+{
+    early.setRoom(room, size);
+    early.setLevel(level);
+    earlyLevel = level;
+}
+
+double ReverbData::getTailLengthSeconds() const
+{
+    // Each time round the loop loses this much, so the number of trips it takes to get down by 1e-6 is log(1e-6) / log(gain).
+    const auto tripsToSilence = [](double loopGain) { return std::log(1.0e-6) / std::log(loopGain); };
+
+    // The reverb freezes at 0.5 and above.
+    if (currentReverbParams.freezeMode >= 0.5f || feedback >= 1.0f)
+        return std::numeric_limits<double>::infinity();
+
+    // The comb needs at least one trip round to empty out.
+    const auto combDelaySeconds = (double)readHeadDelaySamples / (double)setSampleRate;
+    auto combTail = feedback > 0.0f ? combDelaySeconds * juce::jmax(1.0, tripsToSilence(feedback)) : combDelaySeconds;
+
+    // The last reflection arrives this long after the input stops, and everything after it is fed by it.
+    if (earlyLevel > 0.0f)
+        combTail += EarlyReflections::maxTapSeconds;
+
+    if (currentReverbParams.wetLevel <= 0.0f)
+        return combTail;
+
+    if (engine != 0)
+        return combTail + fdn.getTailLengthSeconds();
+
+    // The reverb is a Freeverb whose comb feedback is roomSize * 0.28 + 0.7, its longest comb is 1617 samples
+    // at 44.1kHz plus 23 for the stereo spread, and the allpasses after it add a little bit more on top.
+    const auto roomFeedback = (double)currentReverbParams.roomSize * 0.28 + 0.7;
+    const auto longestCombSeconds = (1617.0 + 23.0) / 44100.0;
+    const auto allpassSeconds = (556.0 + 441.0 + 341.0 + 225.0 + 4.0 * 23.0) / 44100.0;
+
+    return combTail + longestCombSeconds * tripsToSilence(roomFeedback) + allpassSeconds;
+}
+
+size_t ReverbData::getFootprintBytes() const
+{
+    // Freeverb has 8 combs and 4 allpasses per channel, the right channel's are 23 samples longer, all scaled from 44.1kHz.
+    const auto freeverbSamples = (1116 + 1188 + 1277 + 1356 + 1422 + 1491 + 1557 + 1617 + 556 + 441 + 341 + 225) * 2 + 12 * 23;
+    const auto freeverbBytes = (size_t)(freeverbSamples * setSampleRate / 44100.0f) * sizeof(float);
+
+    return DspArena::getBufferSize(circleBuffer.getNumChannels(), circleBuffer.getNumSamples())
+         + fdn.getFootprintBytes() + early.getFootprintBytes() + freeverbBytes;
+}
+
+void ReverbData::processComb(juce::dsp::AudioBlock<float>& block)
+{
+    const auto numChannels = juce::jmin((int)block.getNumChannels(), circleBuffer.getNumChannels());
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        // The two buffers for the respective data.
+        auto incomingData = block.getChannelPointer((size_t)channel);
+        auto circleRead = circleBuffer.getReadPointer(channel);
+        auto circleWrite = circleBuffer.getWritePointer(channel);
+        for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+        {
+            // The clean signal coming through.
+            float cleanSignal = incomingData[sample];
+
+            // Get the current readPosition which is the current position of the circle buffer write head - the delay in samples
+            int readPos = writeHeadSamplePosition - readHeadDelaySamples;
+
+            // If the read position is in the negatives, its actual position is simply the length of the buffer minus its magnitute
+            if (readPos < 0)
+                readPos = circleBuffer.getNumSamples() + readPos;
+
+            // The total signal is just the feedback + the current incoming audio. With the feedback being channgable.
+            // Divide by the total max volume of the feedback data and incoming data
+            // The guard adds a tiny offset so the feedback never dies away into denormals.
+            float signal = (feedback * circleRead[readPos]) + guard.next();// + incomingData[sample]) / (1.0f + feedback);
+
+            // The value to output is just the signal with an option to change the wet/dry
+            incomingData[sample] = signal; //* mix + cleanSignal * (1.0f - mix);
+
+            // The value at the Circle buffer read head position is the same.
+            circleWrite[writeHeadSamplePosition] = incomingData[sample];
+
+            // Increment the write head position.
+            writeHeadSamplePosition++;
+
+            // If the Write Head Position is the same size as the circleBuffer after incrementing, return it back to 0.
+            if (writeHeadSamplePosition >= circleBuffer.getNumSamples())
+                writeHeadSamplePosition = 0;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    ReverbData.h
+    Created: 18 Oct 2026 10:31:07am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "FdnReverb.h"
+#include "EarlyReflections.h"
+#include "../../../Shared/FeedbackGuard.h"
+#include "../../../Shared/DspArena.h"
+#include "../../../Shared/ReBlocker.h"
+
+class ReverbData
+{
+public:
+    // What prepareToPlay() takes from the arena, the comb, the early reflections and the delay network together.
+    static size_t getRequiredBytes(double sampleRate, int samplesPerBlock, int numChannels);
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels, DspArena& arena);
+    void process(juce::AudioBuffer<float>& buffer);
+    void process(juce::dsp::AudioBlock<float>& block);
+    void reset();
+    void updateParameters(const juce::dsp::Reverb::Parameters& reverbParams, const float newMix, const float newDelayLine, const float newFeedback);
+
+    // Which reverb follows the comb. 0 is juce::dsp::Reverb, 1 and 2 are the feedback delay network with 8 or 16 lines.
+    void setEngine(const int newEngine);
+
+    // The early reflections mixed in ahead of the comb and the reverb. The size is the reverb's room size.
+    void setEarlyReflections(const EarlyReflections::Room room, const float size, const float level);
+
+    // How long the comb and the reverb keep going after the input stops, down to -120dB.
+    // Freezing, or a comb feedback of 1, never dies away so that comes back as infinity.
+    double getTailLengthSeconds() const;
+
+    // Everything this holds outside of the object itself. juce::dsp::Reverb allocates its own, so that part is
+    // worked out from the Freeverb line lengths rather than coming from the arena.
+    size_t getFootprintBytes() const;
+
+    // This the is the maximum setable delay.
+    static constexpr float maxDelayTimeSeconds{ 0.1f };
+
+private:
+    // Everything for a piece of the block no longer than it was prepared for.
+    void processChunk(juce::dsp::AudioBlock<float>& block);
+
+    // Runs the comb over every channel of the block, before the reverb gets to it.
+    void processComb(juce::dsp::AudioBlock<float>& block);
+
+    // The default reverb supplied within the DSP framework
+    juce::dsp::Reverb reverb;
+
+    // The denser alternative to the reverb above, it takes the same parameters.
+    FdnReverb fdn;
+    int engine{ 0 };
+
+    // The first echoes off the walls, tapped from the clean input.
+    EarlyReflections early;
+    float earlyLevel{ 0.0f };
+
+    // The last parameters handed to the reverb, kept for working out the tail.
+    juce::dsp::Reverb::Parameters currentReverbParams;
+
+    // A circular buffer meant to hold the previous data. It points into the arena.
+    juce::AudioBuffer<float> circleBuffer;
+
+    // As 2 times the maxDelay length.
+    static int getCircleLength(double sampleRate) { return (int)(maxDelayTimeSeconds * sampleRate * 2); }
+
+    // Sample Rate
+    float setSampleRate{ 44800.0f };
+
+    // How far behind the read head is in samples
+    int readHeadDelaySamples{ 0 };
+
+    // The current position of the write head.
+    int writeHeadSamplePosition{ 0 };
+
+    // The values of the comb knobs for the current block.
+    float mix{ 1.0f };
+    float delayLine{ 0.05f };
+    float feedback{ 0.99f };
+
+    bool isPrepared{ false };
+    int maxBlockSize{ 0 };
+
+    // Feeds the anti denormal offset into the comb, and checks every block on its way out. One bad block
+    // resets everything, otherwise a NaN would go round the comb and the reverb forever.
+    // The offset is always the guard's DC one, never the noise. Nothing in the comb's feedback or the reverbs
+    // after it blocks DC, since their damping is a low pass, so the offset keeps going round and never gets
+    // filtered out, and it is cheaper than drawing a random number for every sample.
+    FeedbackGuard guard;
+};
@@ -23,6 +23,8 @@ SimpleReverbAudioProcessor::SimpleReverbAudioProcessor()
                        ), apvts(*this, nullptr, "PARAMETERS", createParams())
 #endif
 {
+    // Controller 20 onwards drive the parameters in the order they were added, skipping any the MIDI spec defines.
+    scheduler.mapControllers(getParameters(), firstMappedController, &apvts);
 }
 
 SimpleReverbAudioProcessor::~SimpleReverbAudioProcessor()
@@ -64,66 +66,56 @@ bool SimpleReverbAudioProcessor::isMidiEffect() const
 
 double SimpleReverbAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // Hosts use this to know how long to keep running the plugin once the clips under it have ended.
+    return silence.getTailLengthSeconds();
 }
 
 int SimpleReverbAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if you're not really implementing programs.
+    return juce::jmax(1, presets.getNumPresets());
 }
 
 int SimpleReverbAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presets.getCurrentPreset();
 }
 
 void SimpleReverbAudioProcessor::setCurrentProgram (int index)
 {
+    // Only queues the preset, the audio thread switches over to it at the next block.
+    presets.selectPreset(index);
 }
 
 const juce::String SimpleReverbAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presets.getPresetName(index);
 }
 
 void SimpleReverbAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    presets.renamePreset(index, newName);
 }
 
 //==============================================================================
 void SimpleReverbAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Create a ProcessSpec struct to hold the data needed for the reverbs Prepare function
-    juce::dsp::ProcessSpec spec;
-    
-    // Define the 3 variables that a ProcessSpec can hold.
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = getNumInputChannels();
-
-    // Prepare the reverb for play.
-    reverb.prepare(spec);
-
-
-
-    setSampleRate = sampleRate;
-
-    // Sets how many samples behind the write head the read head is. Start at its max value
-    readHeadDelaySamples = sampleRate * maxDelayTimeSeconds;
-
-    // Sets the size of the circular buffer. As 4 times the maxDelay length.
-    circleBuffer.setSize(getNumInputChannels(), maxDelayTimeSeconds * sampleRate * 2, false, false, true);
-
-    // Clear the contents of the circleBuffer for now
-    circleBuffer.clear();
-
+    // The comb and the reverb both live in ReverbData now.
+    // The same spec as last time fits in the slab that's already there, so nothing gets allocated.
+    arena.prepare(ReverbData::getRequiredBytes(sampleRate, samplesPerBlock, getNumInputChannels()));
+    reverb.prepareToPlay(sampleRate, samplesPerBlock, getNumInputChannels(), arena);
+    silence.setTailLengthSeconds(reverb.getTailLengthSeconds());
+    scheduler.prepareToPlay(sampleRate, samplesPerBlock);
+    presets.prepareToPlay(sampleRate);
+    silence.prepareToPlay(sampleRate, samplesPerBlock);
 }
 
 void SimpleReverbAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    presets.releaseResources();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -167,71 +159,59 @@ void SimpleReverbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // Create a place to hold the reverb parameters
-    juce::dsp::Reverb::Parameters reverbParams;
-
-    // Get the values of all the Reverb Params.
-    reverbParams.damping = apvts.getRawParameterValue("DAMPING")->load();
-    reverbParams.dryLevel = apvts.getRawParameterValue("DRY")->load();
-    reverbParams.freezeMode = apvts.getRawParameterValue("FREEZE")->load();
-    reverbParams.roomSize = apvts.getRawParameterValue("SIZE")->load();
-    reverbParams.wetLevel = apvts.getRawParameterValue("WET")->load();
-    reverbParams.width = apvts.getRawParameterValue("WIDTH")->load();
-    
-    // Set the reverb params.
-    reverb.setParameters(reverbParams);
+    // Switches to a newly selected preset once the output has faded out for it.
+    presets.beginBlock();
 
-    float mix = apvts.getRawParameterValue("MIX")->load();
-    float delayLine = apvts.getRawParameterValue("DELAYLINE")->load();
-    float feedback = apvts.getRawParameterValue("FEEDBACK")->load();
+    // While nothing is coming in or ringing out, the block is left as zeros and the DSP below is skipped.
+    const auto isActive = silence.beginBlock(buffer);
 
-    //readHeadDelaySamples = (int)((float)setSampleRate * delayLine);
-    readHeadDelaySamples = 1000;
+    if (! isActive)
+        buffer.clear();
 
-    for (int channel = 0; channel < getNumInputChannels(); ++channel)
-    {
-        // The two buffers for the respective data.
-        auto incomingData = buffer.getWritePointer(channel);
-        auto circleRead = circleBuffer.getReadPointer(channel);
-        auto circleWrite = circleBuffer.getWritePointer(channel);
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-        {
-            // The clean signal coming through.
-            float cleanSignal = incomingData[sample];
-
-            // Get the current readPosition which is the current position of the circle buffer write head - the delay in samples
-            int readPos = writeHeadSamplePosition - readHeadDelaySamples;
-
-            // If the read position is in the negatives, its actual position is simply the length of the buffer minus its magnitute
-            if (readPos < 0)
-                readPos = circleBuffer.getNumSamples() + readPos;
-
-            // The total signal is just the feedback + the current incoming audio. With the feedback being channgable.
-            // Divide by the total max volume of the feedback data and incoming data
-            float signal = (feedback * circleRead[readPos]);// + incomingData[sample]) / (1.0f + feedback);
-
-            // The value to output is just the signal with an option to change the wet/dry
-            incomingData[sample] = signal; //* mix + cleanSignal * (1.0f - mix);
-
-            // The value at the Circle buffer read head position is the same.
-            circleWrite[writeHeadSamplePosition] = incomingData[sample];
-
-            // Increment the write head position.
-            writeHeadSamplePosition++;
-
-            // If the Write Head Position is the same size as the circleBuffer after incrementing, return it back to 0.
-            if (writeHeadSamplePosition >= circleBuffer.getNumSamples())
-                writeHeadSamplePosition = 0;
-        }
-    }
-    // Creats an instance of an AudioBlock of type float out of the buffer object
     juce::dsp::AudioBlock<float> block{ buffer };
-    
-    // Sets up the context to use which is of type float and relys on block.
-    auto contextToUse = juce::dsp::ProcessContextReplacing<float>(block);
 
-    // Get the reverb to process the data in this block
-    reverb.process(contextToUse);
+    // The parameters are read again for every segment, so a controller change lands on the right sample.
+    scheduler.process(buffer.getNumSamples(), midiMessages, [&](int startSample, int numSamples)
+    {
+        // Asleep, so the segments only go by to keep the mapped controllers moving.
+        if (! isActive)
+            return;
+
+        // Create a place to hold the reverb parameters
+        juce::dsp::Reverb::Parameters reverbParams;
+
+        // Get the values of all the Reverb Params.
+        reverbParams.damping = apvts.getRawParameterValue("DAMPING")->load();
+        reverbParams.dryLevel = apvts.getRawParameterValue("DRY")->load();
+        reverbParams.freezeMode = apvts.getRawParameterValue("FREEZE")->load();
+        reverbParams.roomSize = apvts.getRawParameterValue("SIZE")->load();
+        reverbParams.wetLevel = apvts.getRawParameterValue("WET")->load();
+        reverbParams.width = apvts.getRawParameterValue("WIDTH")->load();
+
+        float mix = apvts.getRawParameterValue("MIX")->load();
+        float delayLine = apvts.getRawParameterValue("DELAYLINE")->load();
+        float feedback = apvts.getRawParameterValue("FEEDBACK")->load();
+
+        // Set the reverb and comb params.
+        reverb.updateParameters(reverbParams, mix, delayLine, feedback);
+        reverb.setEngine((int)apvts.getRawParameterValue("ENGINE")->load());
+        reverb.setEarlyReflections((EarlyReflections::Room)(int)apvts.getRawParameterValue("ERROOM")->load(),
+                                   reverbParams.roomSize, apvts.getRawParameterValue("ERLEVEL")->load());
+
+        // Runs the early reflections, the comb and then the reverb over this segment.
+        auto subBlock = block.getSubBlock((size_t)startSample, (size_t)numSamples);
+        reverb.process(subBlock);
+    });
+
+    // The tail follows the comb feedback, the room size and freeze, so it is worked out again every block.
+    // When it finally falls asleep the comb and reverb are cleared, so it wakes up from nothing.
+    silence.setTailLengthSeconds(reverb.getTailLengthSeconds());
+
+    if (silence.endBlock(buffer))
+        reverb.reset();
+
+    // Fades out ahead of a queued preset, or back in after one was applied.
+    presets.endBlock(buffer);
 }
 
 //==============================================================================
@@ -253,15 +233,9 @@ void SimpleReverbAudioProcessor::getStateInformation (juce::MemoryBlock& destDat
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
-    
-    // Gets the state of the ValueTree
-    auto state = apvts.copyState();
-    
-    // Creates a unique pointer of type XmlElement called xml and initialized with the apvts state
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-
-    // Converts Xml to a binary blob.
-    copyXmlToBinary(*xml, destData);
+
+    // Writes every parameter into a small binary blob which is much quicker to load than XML.
+    StateSerializer::save(*this, destData);
 }
 
 void SimpleReverbAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -269,17 +243,8 @@ void SimpleReverbAudioProcessor::setStateInformation (const void* data, int size
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
 
-    // A unique ptr that gets the Xml Data from the Binary
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    // As long as there is information in the xmlState
-    if (xmlState.get() != nullptr)
-        
-        // If the state has the tag name associated with apvts
-        if (xmlState->hasTagName(apvts.state.getType()))
-            
-            // Changes the state of the Value Tree State to what ever was saved.
-            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+    // Reads the binary blob back. Sessions saved before it existed hold the apvts state as XML, which still loads.
+    StateSerializer::load(*this, data, sizeInBytes);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleReverbAudioProcessor::createParams()
@@ -297,9 +262,16 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleReverbAudioProcessor::
 
     // Parameters for the Comb Reverb
     layout.add(std::make_unique<juce::AudioParameterFloat>("MIX", "Mix", 0.0f, 1.0f, 1.0f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>("DELAYLINE", "Delay Line", 0.00f, maxDelayTimeSeconds, 0.05f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("DELAYLINE", "Delay Line", 0.00f, ReverbData::maxDelayTimeSeconds, 0.05f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("FEEDBACK", "Feedback", 0.0f, 1.0f, 0.99f));
 
+    // Which reverb comes after the comb, the feedback delay network is denser and cheaper per sample than Freeverb.
+    layout.add(std::make_unique<juce::AudioParameterChoice>("ENGINE", "Engine", juce::StringArray{ "Freeverb", "FDN 8", "FDN 16" }, 0));
+
+    // The early reflections of a shoebox room ahead of the reverb, off by default. The size knob above scales the room.
+    layout.add(std::make_unique<juce::AudioParameterFloat>("ERLEVEL", "Early Level", 0.0f, 1.0f, 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("ERROOM", "Early Room", juce::StringArray{ "Booth", "Room", "Studio", "Hall" }, 1));
+
     // Return the parameter layout.
     return layout;
 }
@@ -9,6 +9,11 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "Data/ReverbData.h"
+#include "../../Shared/SubBlockScheduler.h"
+#include "../../Shared/StateSerializer.h"
+#include "../../Shared/PresetBank.h"
+#include "../../Shared/SilenceDetector.h"
 
 //==============================================================================
 /**
@@ -56,31 +61,22 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-private:
-    // The default reverb supplied within the DSP framework
-    juce::dsp::Reverb reverb;
-
-
-    // A circular buffer meant to hold the previous data.
-    juce::AudioBuffer<float> circleBuffer;
-
-    // Sample Rate
-    float setSampleRate{ 44800.0f };
+    // Everything this instance holds for its DSP, for keeping an eye on memory with a lot of instances open.
+    size_t getDspFootprintBytes() const { return sizeof(*this) + reverb.getFootprintBytes(); }
 
-    // How long the read heads delay is behind the write head in samples.
-    float delayTimeSeconds{ 0.03f };
-
-    // This the is the maximum setable delay.
-    const float maxDelayTimeSeconds{ 0.1f };
+private:
+    // Every DSP buffer comes out of this, it has to outlive everything using it so it goes first.
+    DspArena arena;
 
-    // How far behind the read head is in samples
-    int readHeadDelaySamples{ 0 };
+    // Holds the comb and the reverb supplied within the DSP framework
+    ReverbData reverb;
 
-    // The current position of the write head.
-    int writeHeadSamplePosition{ 0 };
+    // Splits each block up at its MIDI events.
+    SubBlockScheduler scheduler;
 
-    // The amount of the read signal that is applied to the current signal.
-    float combFeedback{ 0.92f };
+    // The first MIDI controller that is mapped to a parameter. 20 to 31 are undefined in the MIDI spec, once
+    // they run out the scheduler carries on from the next undefined one, 85.
+    static constexpr int firstMappedController{ 20 };
 
     // The ValueTreeState object
     juce::AudioProcessorValueTreeState apvts;
@@ -88,6 +84,12 @@ private:
     // Creates a Parameter Layout for the Value Tree State
     juce::AudioProcessorValueTreeState::ParameterLayout createParams();
 
+    // Every preset as a snapshot of parameter values, switched over without locking.
+    PresetBank presets{ *this, &apvts };
+
+    // Skips the DSP while the input and anything left ringing out are both silent.
+    SilenceDetector silence;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleReverbAudioProcessor)
 };
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    StereoImage.cpp
+    Created: 19 Oct 2026 1:41:12am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "StereoImage.h"
+
+void StereoImage::prepareToPlay(double sampleRate)
+{
+    hostSampleRate = sampleRate;
+    reset();
+}
+
+void StereoImage::reset()
+{
+    sideHighPassState = 0.0f;
+    sumLR = sumLL = sumRR = 0.0;
+}
+
+void StereoImage::updateParameters(const Mode newMode, const float newWidth, const float sideHighPassFrequency)
+{
+    // Going between modes changes what the channels hold, so the filter starts again from nothing.
+    if (newMode != mode)
+        sideHighPassState = 0.0f;
+
+    mode = newMode;
+    width = newWidth;
+
+    const auto wasOn = sideHighPassOn;
+    sideHighPassOn = sideHighPassFrequency > sideHighPassOff;
+
+    if (sideHighPassOn && ! wasOn)
+        sideHighPassState = 0.0f;
+
+    // The TPT integrator gain, g / (1 + g) with the cutoff prewarped.
+    const auto cutoff = juce::jmin((double)sideHighPassFrequency, hostSampleRate * 0.49);
+    const auto g = std::tan(juce::MathConstants<double>::pi * cutoff / hostSampleRate);
+    sideHighPassGain = (float)(g / (1.0 + g));
+}
+
+void StereoImage::process(float* left, float* right, int numSamples, bool flipped)
+{
+    if (numSamples <= 0)
+        return;
+
+    if (isNeutral())
+    {
+        if (flipped)
+            std::swap_ranges(left, left + numSamples, right);
+
+        StereoScopeSource::accumulate(left, right, numSamples, sumLL, sumRR, sumLR);
+        return;
+    }
+
+    // Already M/S in decode mode, otherwise the left becomes the mid and the right the side.
+    if (mode != Mode::decode)
+        encode(left, right, numSamples);
+
+    auto* mid = left;
+    auto* side = right;
+
+    if (sideHighPassOn)
+        highPassSide(side, numSamples);
+
+    const auto sideGain = flipped ? -width : width;
+
+    // The output is worked out from the mid and side sums, with L = M + wS and R = M - wS,
+    // so the meter always shows the decoded image even when the output is left as M/S.
+    double sumMM = 0.0, sumSS = 0.0, sumMS = 0.0;
+    StereoScopeSource::accumulate(mid, side, numSamples, sumMM, sumSS, sumMS);
+
+    const auto w = (double)sideGain;
+    sumLR += sumMM - w * w * sumSS;
+    sumLL += sumMM + 2.0 * w * sumMS + w * w * sumSS;
+    sumRR += sumMM - 2.0 * w * sumMS + w * w * sumSS;
+
+    if (mode == Mode::encode)
+        juce::FloatVectorOperations::multiply(side, sideGain, numSamples);
+    else
+        decode(mid, side, numSamples, sideGain);
+}
+
+void StereoImage::endBlock(StereoScopeSource& meter)
+{
+    meter.addSums(sumLR, sumLL, sumRR);
+    sumLR = sumLL = sumRR = 0.0;
+}
+
+void StereoImage::encode(float* left, float* right, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto l = left[i];
+        const auto r = right[i];
+        left[i] = (l + r) * 0.5f;
+        right[i] = (l - r) * 0.5f;
+    }
+}
+
+void StereoImage::decode(float* mid, float* side, int numSamples, float sideGain)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto m = mid[i];
+        const auto s = side[i] * sideGain;
+        mid[i] = m + s;
+        side[i] = m - s;
+    }
+}
+
+void StereoImage::highPassSide(float* side, int numSamples)
+{
+    auto state = sideHighPassState;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto v = (side[i] - state) * sideHighPassGain;
+        const auto lowPass = v + state;
+        state = lowPass + v;
+        side[i] -= lowPass;
+    }
+
+    sideHighPassState = state;
+}
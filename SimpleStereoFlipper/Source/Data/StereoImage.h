@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    StereoImage.h
+    Created: 19 Oct 2026 1:41:12am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../../Shared/StereoScope.h"
+
+// The mid/side stage after the flip. Everything is done in place on the host's two channel pointers: the encode is one
+// butterfly pass that leaves the mid in the left channel and the side in the right, the side high-pass runs on the
+// right channel, and the decode is a second butterfly that takes the width with it. Flipping left for right is the
+// same as turning the side upside down, so a flip is only a negative width and costs nothing extra.
+// Along the way it keeps the sums for the correlation meter, which are handed over once a block.
+class StereoImage
+{
+public:
+    // Stereo goes through M/S and back, encode leaves the output as M/S and decode takes M/S in.
+    enum class Mode { stereo, encode, decode };
+
+    // At or below this the side high-pass is switched off.
+    static constexpr float sideHighPassOff{ 10.0f };
+
+    void prepareToPlay(double sampleRate);
+    void reset();
+    void updateParameters(const Mode newMode, const float newWidth, const float sideHighPassFrequency);
+
+    // Runs over a stretch of the two channels. While flipped the left and right come out swapped.
+    void process(float* left, float* right, int numSamples, bool flipped);
+
+    // Hands the sums from this block over to the meter, so it doesn't have to go over the samples again.
+    void endBlock(StereoScopeSource& meter);
+
+    // In place, mid = (L + R) / 2 and side = (L - R) / 2, so the left ends up holding the mid and the right the side.
+    static void encode(float* left, float* right, int numSamples);
+
+    // In place, L = M + S * sideGain and R = M - S * sideGain, the opposite of encode when the gain is 1.
+    static void decode(float* mid, float* side, int numSamples, float sideGain);
+
+private:
+    // With nothing to do the channels only get swapped and measured, which keeps the output bit for bit as it was.
+    bool isNeutral() const { return mode == Mode::stereo && width == 1.0f && ! sideHighPassOn; }
+
+    // A one pole TPT high-pass, it is the only part that has to go a sample at a time.
+    void highPassSide(float* side, int numSamples);
+
+    double hostSampleRate{ 44100.0 };
+
+    Mode mode{ Mode::stereo };
+    float width{ 1.0f };
+
+    bool sideHighPassOn{ false };
+    float sideHighPassGain{ 0.0f };
+    float sideHighPassState{ 0.0f };
+
+    // The output's L * R, L * L and R * R over the block so far.
+    double sumLR{ 0.0 };
+    double sumLL{ 0.0 };
+    double sumRR{ 0.0 };
+};
@@ -11,11 +11,22 @@
 
 //==============================================================================
 SimpleStereoFlipperAudioProcessorEditor::SimpleStereoFlipperAudioProcessorEditor (SimpleStereoFlipperAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p), scope (p.getScopeSource())
 {
+    addAndMakeVisible(scope);
+
+    setupSlider(flipPeriodSlider, audioProcessor.getFlipPeriod(), flipPeriodAttach);
+    setupSlider(widthSlider, audioProcessor.getWidth(), widthAttach);
+    setupSlider(sideHighPassSlider, audioProcessor.getSideHighPass(), sideHighPassAttach);
+
+    midSideModeBox.setName(audioProcessor.getMidSideMode().getName(20));
+    midSideModeBox.addItemList(audioProcessor.getMidSideMode().choices, 1);
+    midSideModeAttach = std::make_unique<juce::ComboBoxParameterAttachment>(audioProcessor.getMidSideMode(), midSideModeBox);
+    addAndMakeVisible(midSideModeBox);
+
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize (400, 300);
+    setSize (500, 300);
 }
 
 SimpleStereoFlipperAudioProcessorEditor::~SimpleStereoFlipperAudioProcessorEditor()
@@ -28,13 +39,40 @@ void SimpleStereoFlipperAudioProcessorEditor::paint (juce::Graphics& g)
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
 
+    // Each control's name goes in the gap to its left.
     g.setColour (juce::Colours::white);
-    g.setFont (15.0f);
-    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
+    g.setFont (14.0f);
+
+    for (auto* control : std::initializer_list<juce::Component*>{ &flipPeriodSlider, &widthSlider, &sideHighPassSlider, &midSideModeBox })
+        g.drawFittedText (control->getName(), control->getBounds().withX (scope.getRight() + 5).withRight (control->getX()),
+                          juce::Justification::centredLeft, 1);
 }
 
 void SimpleStereoFlipperAudioProcessorEditor::resized()
 {
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
+    // The scope is square on the left and the controls share the rest.
+    auto bounds = getLocalBounds().reduced(5);
+    scope.setBounds(bounds.removeFromLeft(bounds.getHeight()));
+    bounds.removeFromLeft(5);
+
+    // Room for the names, which paint draws in.
+    bounds.removeFromLeft(100);
+
+    midSideModeBox.setBounds(bounds.removeFromBottom(24));
+    bounds.removeFromBottom(5);
+
+    const auto sliderHeight = bounds.getHeight() / 3;
+    flipPeriodSlider.setBounds(bounds.removeFromTop(sliderHeight));
+    widthSlider.setBounds(bounds.removeFromTop(sliderHeight));
+    sideHighPassSlider.setBounds(bounds);
+}
+
+void SimpleStereoFlipperAudioProcessorEditor::setupSlider(juce::Slider& slider, juce::AudioParameterFloat& parameter,
+                                                          std::unique_ptr<juce::SliderParameterAttachment>& attachment)
+{
+    slider.setSliderStyle(juce::Slider::LinearHorizontal);
+    slider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 60, 20);
+    slider.setName(parameter.getName(20));
+    attachment = std::make_unique<juce::SliderParameterAttachment>(parameter, slider);
+    addAndMakeVisible(slider);
 }
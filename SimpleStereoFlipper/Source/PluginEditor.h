@@ -10,6 +10,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "../../Shared/StereoScope.h"
 
 //==============================================================================
 /**
@@ -25,9 +26,25 @@ public:
     void resized() override;
 
 private:
+    // Gives a rotary slider its parameter and a label underneath.
+    void setupSlider(juce::Slider& slider, juce::AudioParameterFloat& parameter, std::unique_ptr<juce::SliderParameterAttachment>& attachment);
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     SimpleStereoFlipperAudioProcessor& audioProcessor;
 
+    // The goniometer with the correlation meter underneath.
+    StereoScope scope;
+
+    juce::Slider flipPeriodSlider;
+    juce::Slider widthSlider;
+    juce::Slider sideHighPassSlider;
+    juce::ComboBox midSideModeBox;
+
+    std::unique_ptr<juce::SliderParameterAttachment> flipPeriodAttach;
+    std::unique_ptr<juce::SliderParameterAttachment> widthAttach;
+    std::unique_ptr<juce::SliderParameterAttachment> sideHighPassAttach;
+    std::unique_ptr<juce::ComboBoxParameterAttachment> midSideModeAttach;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleStereoFlipperAudioProcessorEditor)
 };
@@ -24,6 +24,16 @@ SimpleStereoFlipperAudioProcessor::SimpleStereoFlipperAudioProcessor()
 {
     // Adds a single parameter that allows the musician to adjust the Flip Period on a knob.
     addParameter(flipPeriod = new juce::AudioParameterFloat("FLIP PERIOD", "Flip Period", 0.01f, 2.5f, 0.25f));
+
+    // The stereo image comes after the flip, added last so the existing MIDI controller stays where it was.
+    addParameter(width = new juce::AudioParameterFloat("WIDTH", "Width", 0.0f, 2.0f, 1.0f));
+    addParameter(sideHighPass = new juce::AudioParameterFloat("SIDE HIGH PASS", "Side High Pass",
+        juce::NormalisableRange<float>(StereoImage::sideHighPassOff, 1000.0f, 0.0f, 0.3f), StereoImage::sideHighPassOff));
+    addParameter(midSideMode = new juce::AudioParameterChoice("MS MODE", "M/S Mode",
+        juce::StringArray{ "Stereo", "Encode", "Decode" }, 0));
+
+    // Controller 20 onwards drive the parameters in the order they were added, skipping any the MIDI spec defines.
+    scheduler.mapControllers(getParameters(), firstMappedController);
 }
 
 SimpleStereoFlipperAudioProcessor::~SimpleStereoFlipperAudioProcessor()
@@ -70,39 +80,47 @@ double SimpleStereoFlipperAudioProcessor::getTailLengthSeconds() const
 
 int SimpleStereoFlipperAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if you're not really implementing programs.
+    return juce::jmax(1, presets.getNumPresets());
 }
 
 int SimpleStereoFlipperAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presets.getCurrentPreset();
 }
 
 void SimpleStereoFlipperAudioProcessor::setCurrentProgram (int index)
 {
+    // Only queues the preset, the audio thread switches over to it at the next block.
+    presets.selectPreset(index);
 }
 
 const juce::String SimpleStereoFlipperAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presets.getPresetName(index);
 }
 
 void SimpleStereoFlipperAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    presets.renamePreset(index, newName);
 }
 
 //==============================================================================
 void SimpleStereoFlipperAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    scheduler.prepareToPlay(sampleRate, samplesPerBlock);
+    presets.prepareToPlay(sampleRate);
+    silence.prepareToPlay(sampleRate, samplesPerBlock);
+    stereoImage.prepareToPlay(sampleRate);
+    scopeSource.prepareToPlay(sampleRate, samplesPerBlock);
 }
 
 void SimpleStereoFlipperAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    presets.releaseResources();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -146,6 +164,15 @@ void SimpleStereoFlipperAudioProcessor::processBlock (juce::AudioBuffer<float>&
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
+    // Switches to a newly selected preset once the output has faded out for it.
+    presets.beginBlock();
+
+    // While nothing is coming in or ringing out, the block is left as zeros and the DSP below is skipped.
+    const auto isActive = silence.beginBlock(buffer);
+
+    if (! isActive)
+        buffer.clear();
+
     // This is the place where you'd normally do the guts of your plugin's
     // audio processing...
     // Make sure to reset the state if your inner loop is processing
@@ -153,53 +180,66 @@ void SimpleStereoFlipperAudioProcessor::processBlock (juce::AudioBuffer<float>&
     // Alternatively, you can process the samples with the channels
     // interleaved by keeping the same state.
 
-    // If it is not on a stereo in and out channel, throw an error and exit.
-    if (getNumInputChannels() < 2 || getNumOutputChannels() < 2) { jassertfalse; };
+    // On a mono bus there is nothing to flip or widen, so the block goes through as it is and only the timing keeps going.
+    const bool isStereo = buffer.getNumChannels() >= 2 && getTotalNumOutputChannels() >= 2;
 
-    // Get a Write Pointer for both the Left and Right Channels.
-    auto* channelDataL = buffer.getWritePointer(0);
-    auto* channelDataR = buffer.getWritePointer(1);
+    // Both channels are worked on in place through the host's own pointers.
+    auto* channelDataL = isStereo ? buffer.getWritePointer(0) : nullptr;
+    auto* channelDataR = isStereo ? buffer.getWritePointer(1) : nullptr;
 
     // Remember that how long a second is is determined by the Sample Rate when measuring using samples.
     const double sampleRate = getSampleRate();
 
-    // Get the Flip Period knobs value and update the lengthUntilFlip which is the amount of seconds before a flip occurs.
-    lengthUntilFlip = flipPeriod->get();
-
-    // Loop through all the samples in the buffer...
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+    // The Flip Period is read again for every segment, so a controller change lands on the right sample.
+    scheduler.process(buffer.getNumSamples(), midiMessages, [&](int startSample, int numSamples)
     {
-        // When it is within the first period, flip the channels.
-        if (samplesForThisFlip < lengthUntilFlip * sampleRate)
+        // Get the Flip Period knobs value and update the lengthUntilFlip which is the amount of seconds before a flip occurs.
+        lengthUntilFlip = flipPeriod->get();
+
+        // Asleep or in mono there is nothing to swap, but the count keeps going so the flips stay in time.
+        if (! isActive || ! isStereo)
         {
-            // Temporary holds the right channels data
-            float tempHolderRight = channelDataR[sample];
-            
-            // The left channel's data is coppied over to the right's, erasing what was there previously.
-            channelDataR[sample] = channelDataL[sample];
-            
-            // Now add back in the temp Right Channel Sample to the Left Channel, completing the channel flip. 
-            channelDataL[sample] = tempHolderRight;
-
-            // Increment the sample count for this flip
-            samplesForThisFlip++;
+            samplesForThisFlip = std::fmod(samplesForThisFlip + numSamples, lengthUntilFlip * 2.0 * sampleRate);
+            return;
         }
-        // When it is within the second period, keep the Left as the Left and the Right as the Right
-        else if (samplesForThisFlip < lengthUntilFlip * 2.0f * sampleRate)
-        {
-            // To illustrate what the algorithm does, I decided to show Left stays Left and Right stays right
-            channelDataL[sample] = channelDataL[sample];
-            channelDataR[sample] = channelDataR[sample];
 
-            // Still, an increment to the total samples made this cycle is necessary.
-            samplesForThisFlip++;
-        }
-        // Finally if over a double period length in samples, set samplesForThisFlip back to 0
-        else
+        stereoImage.updateParameters((StereoImage::Mode)midSideMode->getIndex(), width->get(), sideHighPass->get());
+
+        const double periodLength = lengthUntilFlip * sampleRate;
+        const int endSample = startSample + numSamples;
+
+        // The segment is cut where the flip starts or ends, so each run is either all flipped or all as it was.
+        for (int sample = startSample; sample < endSample;)
         {
-            samplesForThisFlip = 0.0f;
+            // Once over a double period length in samples, set samplesForThisFlip back to 0.
+            if (samplesForThisFlip >= periodLength * 2.0)
+                samplesForThisFlip = 0.0;
+
+            // Within the first period the channels are flipped, within the second Left stays Left and Right stays Right.
+            const bool flipped = samplesForThisFlip < periodLength;
+            const double runEnd = flipped ? periodLength : periodLength * 2.0;
+            const int runLength = juce::jmin(endSample - sample, (int)std::ceil(runEnd - samplesForThisFlip));
+
+            stereoImage.process(channelDataL + sample, channelDataR + sample, runLength, flipped);
+
+            samplesForThisFlip += runLength;
+            sample += runLength;
         }
-    }
+    });
+
+    // The stereo image already has the sums, so the goniometer only needs its points from the output.
+    if (isActive && isStereo)
+        scopeSource.pushPoints(channelDataL, channelDataR, buffer.getNumSamples());
+
+    // Asleep or in mono there are no sums, so the meter settles back to fully correlated.
+    stereoImage.endBlock(scopeSource);
+    scopeSource.endBlock(buffer.getNumSamples());
+
+    // Swapping channels has no memory, so it can sleep as soon as the input goes quiet.
+    silence.endBlock(buffer);
+
+    // Fades out ahead of a queued preset, or back in after one was applied.
+    presets.endBlock(buffer);
 }
 
 //==============================================================================
@@ -210,11 +250,8 @@ bool SimpleStereoFlipperAudioProcessor::hasEditor() const
 
 juce::AudioProcessorEditor* SimpleStereoFlipperAudioProcessor::createEditor()
 {
-    // Uses the default JUCE interface which is better than the default DAW editor for testing.
-    return new juce::GenericAudioProcessorEditor(this);
-
     // Creates an Editor object with a reference to the AudioProcessor that it stores internally for intra communication.
-    //return new SimpleStereoFlipperAudioProcessorEditor (*this);
+    return new SimpleStereoFlipperAudioProcessorEditor (*this);
 }
 
 //==============================================================================
@@ -223,12 +260,18 @@ void SimpleStereoFlipperAudioProcessor::getStateInformation (juce::MemoryBlock&
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
+
+    // Writes every parameter into a small binary blob which is much quicker to load than XML.
+    StateSerializer::save(*this, destData);
 }
 
 void SimpleStereoFlipperAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
+
+    // Reads the binary blob back, or the old XML state if that is what the session holds.
+    StateSerializer::load(*this, data, sizeInBytes);
 }
 
 //==============================================================================
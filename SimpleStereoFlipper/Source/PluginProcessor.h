@@ -9,6 +9,12 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../../Shared/SubBlockScheduler.h"
+#include "../../Shared/StateSerializer.h"
+#include "../../Shared/PresetBank.h"
+#include "../../Shared/SilenceDetector.h"
+#include "../../Shared/StereoScope.h"
+#include "Data/StereoImage.h"
 
 //==============================================================================
 /**
@@ -56,6 +62,14 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    // The correlation meter and goniometer points for the editor.
+    StereoScopeSource& getScopeSource() { return scopeSource; }
+
+    juce::AudioParameterFloat& getFlipPeriod() { return *flipPeriod; }
+    juce::AudioParameterFloat& getWidth() { return *width; }
+    juce::AudioParameterFloat& getSideHighPass() { return *sideHighPass; }
+    juce::AudioParameterChoice& getMidSideMode() { return *midSideMode; }
+
 private:
     // Holds the Samples accumulating in the flip.
     double samplesForThisFlip{ 0.0f };
@@ -66,6 +80,34 @@ private:
     // The actual knob that controls how often it flips left for right.
     juce::AudioParameterFloat* flipPeriod;
 
+    // How wide the stereo image is, 0 is mono, 1 leaves it as it was and 2 doubles the side.
+    juce::AudioParameterFloat* width;
+
+    // Takes the low end out of the side so the bass stays in the middle, off at the bottom of its range.
+    juce::AudioParameterFloat* sideHighPass;
+
+    // Whether the output is left as M/S or the input is already M/S.
+    juce::AudioParameterChoice* midSideMode;
+
+    // The width, side high-pass and correlation meter, done in place on the two channels.
+    StereoImage stereoImage;
+
+    // Picks up the sums from the stereo image and a point every few samples for the editor.
+    StereoScopeSource scopeSource;
+
+    // Splits each block up at its MIDI events.
+    SubBlockScheduler scheduler;
+
+    // The first MIDI controller that is mapped to a parameter. 20 to 31 are undefined in the MIDI spec, once
+    // they run out the scheduler carries on from the next undefined one, 85.
+    static constexpr int firstMappedController{ 20 };
+
+    // Every preset as a snapshot of parameter values, switched over without locking.
+    PresetBank presets{ *this };
+
+    // Skips the DSP while the input and anything left ringing out are both silent.
+    SilenceDetector silence;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleStereoFlipperAudioProcessor)
 };
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    Compressor.cpp
+    Created: 19 Oct 2026 12:21:07am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "Compressor.h"
+
+namespace
+{
+    // 20 * log10(x) is this times log2(x).
+    constexpr float decibelsPerOctave{ 6.0205999f };
+
+    // Expanding something that is already near silence would otherwise keep turning it down forever.
+    constexpr float maximumReduction{ -96.0f };
+}
+
+void Compressor::prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    hostSampleRate = sampleRate;
+    maxBlockSize = juce::jmax(1, samplesPerBlock);
+    numPreparedChannels = juce::jmax(1, numChannels);
+
+    gains.calloc((size_t)(maxBlockSize * numPreparedChannels));
+    linked.calloc((size_t)maxBlockSize);
+    states.calloc((size_t)numPreparedChannels);
+    reset();
+}
+
+void Compressor::reset()
+{
+    if (states != nullptr)
+        juce::FloatVectorOperations::clear(states.get(), numPreparedChannels);
+
+    gainReductionDecibels = 0.0f;
+}
+
+void Compressor::updateParameters(const Mode newMode, const float thresholdDecibels, const float newRatio, const float kneeDecibels,
+                                  const float attackMilliseconds, const float releaseMilliseconds, const float newLink, const float makeupDecibels)
+{
+    auto coefficient = [this](float milliseconds)
+    {
+        return std::exp(-1.0f / (juce::jmax(0.01f, milliseconds) * 0.001f * (float)hostSampleRate));
+    };
+
+    attackCoefficient = coefficient(attackMilliseconds);
+    releaseCoefficient = coefficient(releaseMilliseconds);
+
+    const auto ratio = juce::jmax(1.0f, newRatio);
+    direction = newMode == Mode::compress ? 1.0f : -1.0f;
+    slope = newMode == Mode::compress ? 1.0f / ratio - 1.0f : 1.0f - ratio;
+
+    threshold = thresholdDecibels;
+    knee = juce::jmax(0.01f, kneeDecibels);
+    link = juce::jlimit(0.0f, 1.0f, newLink);
+    makeup = makeupDecibels;
+}
+
+void Compressor::process(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    jassert(numSamples <= maxBlockSize);
+
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), numPreparedChannels);
+
+    if (numSamples <= 0 || numChannels <= 0)
+        return;
+
+    // The level of every channel, and the loudest of them for the link.
+    juce::FloatVectorOperations::clear(linked.get(), numSamples);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* levels = gains.get() + channel * maxBlockSize;
+        juce::FloatVectorOperations::abs(levels, buffer.getReadPointer(channel, startSample), numSamples);
+        juce::FloatVectorOperations::max(linked.get(), linked.get(), levels, numSamples);
+    }
+
+    const auto halfKnee = knee * 0.5f;
+    const auto inverseDoubleKnee = 1.0f / (2.0f * knee);
+    auto reduction = 0.0f;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* data = gains.get() + channel * maxBlockSize;
+
+        // Each channel follows a blend of itself and the loudest channel.
+        juce::FloatVectorOperations::multiply(data, 1.0f - link, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(data, linked.get(), link, numSamples);
+
+        // The gain computer. Below the knee is nothing, inside it is the quadratic that joins the two lines up
+        // and above it is the slope, all of which comes out of clamping rather than branching.
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto level = decibelsPerOctave * fastLog2(juce::jmax(data[i], 1.0e-9f));
+            const auto distance = direction * (level - threshold);
+            const auto inKnee = juce::jlimit(0.0f, knee, distance + halfKnee);
+            const auto aboveKnee = juce::jmax(0.0f, distance - halfKnee);
+
+            data[i] = juce::jmax(maximumReduction, slope * (inKnee * inKnee * inverseDoubleKnee + aboveKnee));
+        }
+
+        // Turning down uses the attack and letting go uses the release. The comparison is 0 or 1, so picking
+        // the coefficient is a multiply rather than a branch.
+        auto state = states[channel];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto isAttacking = (float)(data[i] < state);
+            const auto coefficient = releaseCoefficient + (attackCoefficient - releaseCoefficient) * isAttacking;
+            state = data[i] + coefficient * (state - data[i]);
+            data[i] = state;
+        }
+
+        states[channel] = state;
+        reduction = juce::jmin(reduction, state);
+
+        // Back to a linear gain with the makeup folded in.
+        const auto offset = makeup / decibelsPerOctave;
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = fastExp2(data[i] * (1.0f / decibelsPerOctave) + offset);
+    }
+
+    gainReductionDecibels = reduction;
+}
+
+void Compressor::applyTo(int channel, float* data, int numSamples, float gain, const float* extraGains) const
+{
+    const auto* curve = gains.get() + juce::jmin(channel, numPreparedChannels - 1) * maxBlockSize;
+
+    if (extraGains != nullptr)
+        SimdKernels::get().multiplyByCurves(data, curve, extraGains, numSamples, gain);
+    else
+        SimdKernels::get().multiplyByCurve(data, curve, numSamples, gain);
+}
+
+float Compressor::fastLog2(float x) noexcept
+{
+    // The exponent bits are the whole part of the answer, and a polynomial fitted to log2(1 + t) on [0, 1)
+    // does the mantissa.
+    juce::int32 bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+
+    const auto exponent = (float)(((bits >> 23) & 255) - 127);
+    const auto mantissaBits = (bits & 0x7fffff) | 0x3f800000;
+
+    float mantissa;
+    std::memcpy(&mantissa, &mantissaBits, sizeof(mantissa));
+
+    const auto t = mantissa - 1.0f;
+    return exponent + t * (1.44187990f + t * (-0.70886522f + t * (0.41524556f + t * (-0.19351652f + t * 0.04526829f))));
+}
+
+float Compressor::fastExp2(float x) noexcept
+{
+    // The whole part goes straight into the exponent bits and a polynomial does 2^f for what is left.
+    x = juce::jlimit(-126.0f, 126.0f, x);
+
+    // x + 127 is always positive, so truncating it is the same as taking the floor.
+    const auto whole = (int)(x + 127.0f) - 127;
+    const auto f = x - (float)whole;
+
+    const auto exponentBits = (juce::int32)(whole + 127) << 23;
+    float power;
+    std::memcpy(&power, &exponentBits, sizeof(power));
+
+    return power * (1.0f + f * (0.6960656f + f * (0.2244943f + f * 0.0794402f)));
+}
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    Compressor.h
+    Created: 19 Oct 2026 12:21:07am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../../Shared/SimdKernels.h"
+
+// A feed forward compressor, or a downward expander, with a soft knee and stereo linking.
+// The gain computer works in the log domain, where the knee is just a couple of min and max calls, and gets
+// there and back with polynomial log2 and exp2 approximations instead of std::log and std::exp. Every pass
+// apart from the attack and release smoothing is a plain loop over the segment that the compiler vectorizes,
+// and the smoothing picks its coefficient without a branch.
+class Compressor
+{
+public:
+    enum class Mode { compress, expand };
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels);
+    void reset();
+
+    // The ratio is how many dB over the threshold give 1dB out when compressing, or how many dB under it
+    // each dB under becomes when expanding. A link of 1 gives every channel the gain of the loudest one.
+    void updateParameters(const Mode newMode, const float thresholdDecibels, const float newRatio, const float kneeDecibels,
+                          const float attackMilliseconds, const float releaseMilliseconds, const float newLink, const float makeupDecibels);
+
+    // Works out the gain for every channel of the segment, from the segment as it is now.
+    void process(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // Multiplies a channel of the segment by its gain and the regular gain at once. extraGains is another curve
+    // to go on in the same pass, like the ducker's, and can be nullptr.
+    void applyTo(int channel, float* data, int numSamples, float gain, const float* extraGains) const;
+
+    // How far the loudest channel ended up turned down in the last segment, for the editor.
+    float getGainReductionDecibels() const { return gainReductionDecibels.load(); }
+
+    // Accurate to about 1e-4 dB and 0.002 dB, which is well under anything you could hear in a gain.
+    static float fastLog2(float x) noexcept;
+    static float fastExp2(float x) noexcept;
+
+private:
+    double hostSampleRate{ 44100.0 };
+    int maxBlockSize{ 0 };
+    int numPreparedChannels{ 0 };
+
+    // One run of maxBlockSize per channel, the level first, then the gain in decibels and finally the linear gain.
+    juce::HeapBlock<float> gains;
+
+    // The loudest channel at each sample, for the link.
+    juce::HeapBlock<float> linked;
+
+    // The smoothed gain of each channel in decibels, carried from one segment to the next.
+    juce::HeapBlock<float> states;
+
+    float attackCoefficient{ 0.0f };
+    float releaseCoefficient{ 0.0f };
+
+    // Compressing looks at how far over the threshold it is and expanding at how far under, so the sign flips
+    // the distance and the slope turns it into a gain. Both end up negative.
+    float direction{ 1.0f };
+    float slope{ 0.0f };
+    float threshold{ 0.0f };
+    float knee{ 0.0f };
+    float link{ 1.0f };
+    float makeup{ 0.0f };
+
+    std::atomic<float> gainReductionDecibels{ 0.0f };
+};
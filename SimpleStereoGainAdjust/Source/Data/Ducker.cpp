@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    Ducker.cpp
+    Created: 18 Oct 2026 11:34:50pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "Ducker.h"
+
+void Ducker::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    hostSampleRate = sampleRate;
+    maxBlockSize = juce::jmax(1, samplesPerBlock);
+    levels.calloc((size_t)maxBlockSize);
+    reset();
+}
+
+void Ducker::reset()
+{
+    envelope = 0.0f;
+    gainReductionDecibels = 0.0f;
+}
+
+void Ducker::updateParameters(const float thresholdDecibels, const float rangeDecibels, const float attackMilliseconds,
+                              const float releaseMilliseconds, const Detector newDetector)
+{
+    // The envelope gets within 1 / e of where it is heading in the attack or release time.
+    auto coefficient = [this](float milliseconds)
+    {
+        return std::exp(-1.0f / (juce::jmax(0.01f, milliseconds) * 0.001f * (float)hostSampleRate));
+    };
+
+    attackCoefficient = coefficient(attackMilliseconds);
+    releaseCoefficient = coefficient(releaseMilliseconds);
+
+    // In RMS mode the envelope follows the squared signal, so the threshold gets squared to match.
+    detector = newDetector;
+    threshold = juce::Decibels::decibelsToGain(thresholdDecibels);
+
+    if (detector == Detector::rms)
+        threshold *= threshold;
+
+    minimumGain = juce::Decibels::decibelsToGain(-rangeDecibels);
+}
+
+void Ducker::process(const juce::AudioBuffer<float>& sidechain, int startSample, int numSamples)
+{
+    jassert(numSamples <= maxBlockSize);
+    auto* data = levels.get();
+
+    if (numSamples <= 0)
+        return;
+
+    // The detector takes the loudest channel, all of it is vectorized.
+    juce::FloatVectorOperations::clear(data, numSamples);
+
+    for (int channel = 0; channel < sidechain.getNumChannels(); ++channel)
+    {
+        const auto* input = sidechain.getReadPointer(channel, startSample);
+
+        if (detector == Detector::rms)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = juce::jmax(data[i], input[i] * input[i]);
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = juce::jmax(data[i], std::abs(input[i]));
+        }
+    }
+
+    // Quick to rise and slow to fall, this is the one part that has to go a sample at a time.
+    auto state = envelope;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto coefficient = data[i] > state ? attackCoefficient : releaseCoefficient;
+        state = data[i] + coefficient * (state - data[i]);
+        data[i] = state;
+    }
+
+    envelope = state;
+
+    // Being x dB over the threshold turns it down by x dB, which in linear terms is just threshold / envelope.
+    // RMS works on the squares, so its ratio needs a square root to come back to a gain.
+    const auto floor = threshold * 1.0e-6f + std::numeric_limits<float>::min();
+    const auto lowest = detector == Detector::rms ? minimumGain * minimumGain : minimumGain;
+
+    for (int i = 0; i < numSamples; ++i)
+        data[i] = juce::jlimit(lowest, 1.0f, threshold / juce::jmax(data[i], floor));
+
+    if (detector == Detector::rms)
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = std::sqrt(data[i]);
+
+    gainReductionDecibels = juce::Decibels::gainToDecibels(data[numSamples - 1]);
+}
+
+void Ducker::applyTo(float* data, int numSamples, float gain) const
+{
+    SimdKernels::get().multiplyByCurve(data, levels.get(), numSamples, gain);
+}
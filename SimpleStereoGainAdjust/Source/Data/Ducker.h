@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    Ducker.h
+    Created: 18 Oct 2026 11:34:50pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../../Shared/SimdKernels.h"
+
+// Turns the main signal down while the sidechain is above the threshold, by as many decibels as the sidechain
+// is over it, up to the range. Each segment is done in passes: the detector over every channel of the sidechain,
+// the envelope, which is the only part that has to go a sample at a time, and the gain, which works in linear
+// units so there is no log or exp per sample. The gain is then multiplied in along with the regular gains.
+class Ducker
+{
+public:
+    enum class Detector { peak, rms };
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+    void reset();
+    void updateParameters(const float thresholdDecibels, const float rangeDecibels, const float attackMilliseconds,
+                          const float releaseMilliseconds, const Detector newDetector);
+
+    // Works out the gain for each sample of the segment from the sidechain. numSamples can't be more than samplesPerBlock.
+    void process(const juce::AudioBuffer<float>& sidechain, int startSample, int numSamples);
+
+    // Multiplies a channel of the segment by the ducking gain and the regular gain at once.
+    void applyTo(float* data, int numSamples, float gain) const;
+
+    // The ducking gain for each sample of the last segment, for when something else applies it.
+    const float* getGains() const { return levels.get(); }
+
+    // How far the last segment ended up turned down, for the editor.
+    float getGainReductionDecibels() const { return gainReductionDecibels.load(); }
+
+private:
+    double hostSampleRate{ 44100.0 };
+
+    // The detector output, then the envelope, then the gain, all in place.
+    juce::HeapBlock<float> levels;
+    int maxBlockSize{ 0 };
+
+    float envelope{ 0.0f };
+    float attackCoefficient{ 0.0f };
+    float releaseCoefficient{ 0.0f };
+
+    // Linear, and squared in RMS mode so the envelope never needs a square root.
+    float threshold{ 1.0f };
+    float minimumGain{ 1.0f };
+    Detector detector{ Detector::peak };
+
+    std::atomic<float> gainReductionDecibels{ 0.0f };
+};
@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 18 Oct 2026 3:22:48pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+
+void LoudnessMeter::prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    juce::ignoreUnused(samplesPerBlock);
+
+    // The BS.1770 filters are given at 48kHz, these are the analogue prototypes so they work at any sample rate.
+    {
+        const auto f0 = 1681.974450955533;
+        const auto gain = 3.999843853973347;
+        const auto q = 0.7071752369554196;
+
+        const auto k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const auto vh = std::pow(10.0, gain / 20.0);
+        const auto vb = std::pow(vh, 0.4996667741545416);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    {
+        const auto f0 = 38.13547087602444;
+        const auto q = 0.5003270373238773;
+
+        const auto k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    filterState.assign((size_t)numChannels, {});
+    samplesPerStep = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    for (auto& state : filterState)
+        state.fill(0.0);
+
+    stepEnergies.fill(0.0);
+    stepPosition = 0;
+    stepsFilled = 0;
+    currentStepSum = 0.0;
+    currentStepSamples = 0;
+
+    blockCounts.fill(0);
+    blockEnergies.fill(0.0);
+    shortTermCounts.fill(0);
+    shortTermEnergies.fill(0.0);
+
+    momentaryLoudness = -std::numeric_limits<float>::infinity();
+    shortTermLoudness = -std::numeric_limits<float>::infinity();
+    integratedLoudness = -std::numeric_limits<float>::infinity();
+    loudnessRange = 0.0f;
+}
+
+void LoudnessMeter::process(const juce::AudioBuffer<float>& buffer)
+{
+    if (resetRequested.exchange(false))
+        reset();
+
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), (int)filterState.size());
+    int sample = 0;
+
+    while (sample < buffer.getNumSamples())
+    {
+        // Work up to the end of the current 100ms step, or the end of the buffer.
+        const auto numSamples = juce::jmin(buffer.getNumSamples() - sample, samplesPerStep - currentStepSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const auto* data = buffer.getReadPointer(channel, sample);
+            auto& state = filterState[(size_t)channel];
+            double sum = 0.0;
+
+            // Both filter stages and the square run together so each sample is only touched once.
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto x = (double)data[i];
+
+                const auto y1 = shelf.b0 * x + state[0];
+                state[0] = shelf.b1 * x - shelf.a1 * y1 + state[1];
+                state[1] = shelf.b2 * x - shelf.a2 * y1;
+
+                const auto y2 = highPass.b0 * y1 + state[2];
+                state[2] = highPass.b1 * y1 - highPass.a1 * y2 + state[3];
+                state[3] = highPass.b2 * y1 - highPass.a2 * y2;
+
+                sum += y2 * y2;
+            }
+
+            // Left and right both have a weighting of 1, only the surround channels would be louder.
+            currentStepSum += sum;
+        }
+
+        sample += numSamples;
+        currentStepSamples += numSamples;
+
+        if (currentStepSamples >= samplesPerStep)
+        {
+            finishStep(currentStepSum / (double)samplesPerStep);
+            currentStepSum = 0.0;
+            currentStepSamples = 0;
+        }
+    }
+}
+
+void LoudnessMeter::finishStep(double stepEnergy)
+{
+    stepEnergies[(size_t)stepPosition] = stepEnergy;
+    stepPosition = (stepPosition + 1) % (int)stepEnergies.size();
+    stepsFilled = juce::jmin(stepsFilled + 1, (int)stepEnergies.size());
+
+    // Sums the most recent steps, going backwards from the newest.
+    auto sumOfLastSteps = [this](int numSteps)
+    {
+        double sum = 0.0;
+
+        for (int i = 1; i <= numSteps; ++i)
+            sum += stepEnergies[(size_t)((stepPosition - i + (int)stepEnergies.size()) % (int)stepEnergies.size())];
+
+        return sum;
+    };
+
+    // Momentary is the last 4 steps, 400ms, and each one is also a gating block for the integrated loudness.
+    if (stepsFilled >= 4)
+    {
+        const auto energy = sumOfLastSteps(4) / 4.0;
+        const auto loudness = energyToLoudness(energy);
+        momentaryLoudness = loudness;
+
+        // Anything under the absolute gate of -70 LUFS never counts.
+        if (loudness > histogramFloor)
+        {
+            const auto bin = loudnessToBin(loudness);
+            ++blockCounts[(size_t)bin];
+            blockEnergies[(size_t)bin] += energy;
+            updateIntegrated();
+        }
+    }
+
+    // Short term is the last 30 steps, 3s, and the range is measured from those.
+    if (stepsFilled >= (int)stepEnergies.size())
+    {
+        const auto energy = sumOfLastSteps((int)stepEnergies.size()) / (double)stepEnergies.size();
+        const auto loudness = energyToLoudness(energy);
+        shortTermLoudness = loudness;
+
+        if (loudness > histogramFloor)
+        {
+            const auto bin = loudnessToBin(loudness);
+            ++shortTermCounts[(size_t)bin];
+            shortTermEnergies[(size_t)bin] += energy;
+            updateRange();
+        }
+    }
+}
+
+void LoudnessMeter::updateIntegrated()
+{
+    // First the average of every block over the absolute gate.
+    double totalEnergy = 0.0;
+    juce::uint64 totalCount = 0;
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        totalEnergy += blockEnergies[(size_t)bin];
+        totalCount += blockCounts[(size_t)bin];
+    }
+
+    if (totalCount == 0)
+        return;
+
+    // Then only the blocks within 10 LU of that average are used for the final value.
+    const auto relativeGate = energyToLoudness(totalEnergy / (double)totalCount) - 10.0f;
+    double gatedEnergy = 0.0;
+    juce::uint64 gatedCount = 0;
+
+    for (int bin = juce::jmax(0, loudnessToBin(relativeGate)); bin < numBins; ++bin)
+    {
+        gatedEnergy += blockEnergies[(size_t)bin];
+        gatedCount += blockCounts[(size_t)bin];
+    }
+
+    if (gatedCount > 0)
+        integratedLoudness = energyToLoudness(gatedEnergy / (double)gatedCount);
+}
+
+void LoudnessMeter::updateRange()
+{
+    double totalEnergy = 0.0;
+    juce::uint64 totalCount = 0;
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        totalEnergy += shortTermEnergies[(size_t)bin];
+        totalCount += shortTermCounts[(size_t)bin];
+    }
+
+    if (totalCount == 0)
+        return;
+
+    // EBU Tech 3342 gates the range 20 LU under the average, then takes the 10th to 95th percentile.
+    const auto firstBin = juce::jmax(0, loudnessToBin(energyToLoudness(totalEnergy / (double)totalCount) - 20.0f));
+    juce::uint64 gatedCount = 0;
+
+    for (int bin = firstBin; bin < numBins; ++bin)
+        gatedCount += shortTermCounts[(size_t)bin];
+
+    if (gatedCount == 0)
+        return;
+
+    const auto lowTarget = (juce::uint64)std::ceil((double)gatedCount * 0.10);
+    const auto highTarget = (juce::uint64)std::ceil((double)gatedCount * 0.95);
+
+    juce::uint64 runningCount = 0;
+    int lowBin = -1, highBin = -1;
+
+    for (int bin = firstBin; bin < numBins && highBin < 0; ++bin)
+    {
+        runningCount += shortTermCounts[(size_t)bin];
+
+        if (lowBin < 0 && runningCount >= lowTarget)
+            lowBin = bin;
+
+        if (runningCount >= highTarget)
+            highBin = bin;
+    }
+
+    if (lowBin >= 0 && highBin >= 0)
+        loudnessRange = binToLoudness(highBin) - binToLoudness(lowBin);
+}
+
+float LoudnessMeter::energyToLoudness(double energy)
+{
+    if (energy <= 0.0)
+        return -std::numeric_limits<float>::infinity();
+
+    return (float)(-0.691 + 10.0 * std::log10(energy));
+}
+
+int LoudnessMeter::loudnessToBin(float loudness)
+{
+    return juce::jlimit(0, numBins - 1, (int)std::floor((loudness - histogramFloor) / binWidth));
+}
+
+float LoudnessMeter::binToLoudness(int bin)
+{
+    // The middle of the bin.
+    return histogramFloor + ((float)bin + 0.5f) * binWidth;
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 18 Oct 2026 3:22:48pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Measures loudness the way EBU R128 / ITU BS.1770 asks for it: momentary (400ms), short term (3s),
+// gated integrated loudness and loudness range. Everything is worked out from 100ms steps,
+// and the gating uses fixed histograms so the cost never grows with the length of the programme.
+class LoudnessMeter
+{
+public:
+    void prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels);
+    void process(const juce::AudioBuffer<float>& buffer);
+    void reset();
+
+    // Asks the audio thread to start the integrated loudness and range again, safe to call from anywhere.
+    void requestReset() { resetRequested = true; }
+
+    // All in LUFS (or LU for the range), silence reads as -inf.
+    float getMomentaryLoudness() const  { return momentaryLoudness.load(); }
+    float getShortTermLoudness() const  { return shortTermLoudness.load(); }
+    float getIntegratedLoudness() const { return integratedLoudness.load(); }
+    float getLoudnessRange() const      { return loudnessRange.load(); }
+
+private:
+    // A biquad in transposed direct form II, one set of state per channel.
+    struct Biquad
+    {
+        double b0{ 1.0 }, b1{ 0.0 }, b2{ 0.0 }, a1{ 0.0 }, a2{ 0.0 };
+    };
+
+    // Called every 100ms with the mean square of the step that just finished.
+    void finishStep(double stepEnergy);
+
+    void updateIntegrated();
+    void updateRange();
+
+    static float energyToLoudness(double energy);
+    static int loudnessToBin(float loudness);
+    static float binToLoudness(int bin);
+
+    // The two stages of the K-weighting filter, a high shelf and then a high pass.
+    Biquad shelf, highPass;
+    std::vector<std::array<double, 4>> filterState;
+
+    // The energy of each of the last 30 steps, enough for a short term window.
+    std::array<double, 30> stepEnergies{};
+    int stepPosition{ 0 };
+    int stepsFilled{ 0 };
+
+    double currentStepSum{ 0.0 };
+    int currentStepSamples{ 0 };
+    int samplesPerStep{ 4410 };
+
+    // Loudness from -70 to +10 LUFS in 0.1 LU bins.
+    static constexpr float histogramFloor{ -70.0f };
+    static constexpr float binWidth{ 0.1f };
+    static constexpr int numBins{ 800 };
+
+    // How many momentary blocks landed in each bin, and their total energy.
+    std::array<juce::uint32, numBins> blockCounts{};
+    std::array<double, numBins> blockEnergies{};
+
+    // The same for the short term loudness, which is what the range is measured from.
+    std::array<juce::uint32, numBins> shortTermCounts{};
+    std::array<double, numBins> shortTermEnergies{};
+
+    std::atomic<bool> resetRequested{ false };
+
+    std::atomic<float> momentaryLoudness{ -std::numeric_limits<float>::infinity() };
+    std::atomic<float> shortTermLoudness{ -std::numeric_limits<float>::infinity() };
+    std::atomic<float> integratedLoudness{ -std::numeric_limits<float>::infinity() };
+    std::atomic<float> loudnessRange{ 0.0f };
+};
@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+    TruePeakLimiter.cpp
+    Created: 18 Oct 2026 2:04:19pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "TruePeakLimiter.h"
+
+void TruePeakLimiter::prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    hostSampleRate = sampleRate;
+    maximumBlockSize = juce::jmax(1, samplesPerBlock);
+
+    // Two 2x stages give 4x. Only the upsampling half is ever run since the result is just measured.
+    oversampler = std::make_unique<juce::dsp::Oversampling<float>>((size_t)numChannels, 2,
+        juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple, false);
+    oversampler->initProcessing((size_t)maximumBlockSize);
+
+    detectionBuffer.setSize(numChannels, maximumBlockSize);
+
+    windowLength = juce::jmax(1, (int)std::ceil(sampleRate * lookaheadSeconds));
+
+    // The up and down filters are the same length, so the detection is behind by half of the reported latency.
+    // Rounding up means the gain is always down a touch early rather than a touch late.
+    const auto detectionLatency = (int)std::ceil(oversampler->getLatencyInSamples() * 0.5f);
+
+    // The audio waits for the detection plus the window, less one since the window includes the current sample.
+    latencySamples = detectionLatency + windowLength - 1;
+
+    delayBuffer.setSize(numChannels, juce::jmax(1, latencySamples));
+
+    peaks.allocate((size_t)maximumBlockSize, true);
+    gains.allocate((size_t)maximumBlockSize, true);
+
+    dequeCapacity = windowLength + 1;
+    dequeIndices.allocate((size_t)dequeCapacity, true);
+    dequeValues.allocate((size_t)dequeCapacity, true);
+
+    averageHistory.allocate((size_t)windowLength, true);
+
+    fadeStep = (float)(1.0 / juce::jmax(1.0, sampleRate * fadeSeconds));
+
+    reset();
+    updateParameters(enabled, juce::Decibels::gainToDecibels(ceiling), 100.0f, softClipEnabled);
+}
+
+void TruePeakLimiter::reset()
+{
+    if (oversampler != nullptr)
+        oversampler->reset();
+
+    delayBuffer.clear();
+    delayWritePosition = 0;
+
+    dequeFront = 0;
+    dequeSize = 0;
+    sampleCounter = 0;
+
+    // The average starts full of unity gain so nothing gets turned down at the start.
+    for (int i = 0; i < windowLength; ++i)
+        averageHistory[i] = 1.0f;
+
+    averageSum = (double)windowLength;
+    averagePosition = 0;
+    releasedGain = 1.0f;
+
+    // With nothing left in the delay there is nothing to fade, so the limiter goes straight to where it is headed.
+    wetLevel = enabled ? 1.0f : 0.0f;
+    bypassed = ! enabled;
+}
+
+void TruePeakLimiter::updateParameters(const bool isEnabled, const float ceilingDecibels, const float releaseMilliseconds, const bool isSoftClipEnabled)
+{
+    enabled = isEnabled;
+    softClipEnabled = isSoftClipEnabled;
+    ceiling = juce::Decibels::decibelsToGain(ceilingDecibels);
+
+    // A one pole that covers about 63% of the way back to unity gain in the release time.
+    releaseCoefficient = 1.0f - std::exp(-1.0f / (float)(hostSampleRate * releaseMilliseconds * 0.001));
+}
+
+void TruePeakLimiter::process(juce::AudioBuffer<float>& buffer)
+{
+    if (enabled && bypassed)
+    {
+        // Coming back from bypass the delay and the detection start again from silence,
+        // so the limited signal fades in over the dry one.
+        reset();
+        wetLevel = 0.0f;
+    }
+
+    // Switched off and faded out, the audio is left exactly as it came in.
+    if (bypassed)
+        return;
+
+    // Some hosts send more than they promised, so anything longer is done in pieces.
+    for (int start = 0; start < buffer.getNumSamples(); start += maximumBlockSize)
+        processChunk(buffer, start, juce::jmin(maximumBlockSize, buffer.getNumSamples() - start));
+
+    // Once the fade to the dry signal is done the delay can stop, and the latency goes with it.
+    if (! enabled && wetLevel <= 0.0f)
+        bypassed = true;
+}
+
+void TruePeakLimiter::processChunk(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), delayBuffer.getNumChannels());
+
+    // This keeps limiting while it fades out after being switched off, so the delayed part never goes over the ceiling.
+    detectPeaks(buffer, startSample, numSamples);
+    computeGain(numSamples);
+
+    const auto targetLevel = enabled ? 1.0f : 0.0f;
+    const auto isFading = wetLevel != targetLevel;
+
+    const auto delayLength = delayBuffer.getNumSamples();
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* data = buffer.getWritePointer(channel, startSample);
+        auto* delay = delayBuffer.getWritePointer(channel);
+        auto position = delayWritePosition;
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            // Swap the incoming sample for the one that went in a delay length ago.
+            const auto delayed = delay[position];
+            delay[position] = data[sample];
+
+            if (++position >= delayLength)
+                position = 0;
+
+            data[sample] = delayed * gains[sample];
+        }
+
+        if (softClipEnabled)
+            for (int sample = 0; sample < numSamples; ++sample)
+                data[sample] = softClip(data[sample]);
+
+        if (isFading)
+        {
+            // The detection buffer still holds the dry input of this chunk, the limited signal is faded over it.
+            const auto* dry = detectionBuffer.getReadPointer(channel);
+            auto level = wetLevel;
+
+            for (int sample = 0; sample < numSamples; ++sample)
+            {
+                level = targetLevel > level ? juce::jmin(targetLevel, level + fadeStep) : juce::jmax(targetLevel, level - fadeStep);
+                data[sample] = dry[sample] + (data[sample] - dry[sample]) * level;
+            }
+        }
+    }
+
+    if (isFading)
+    {
+        const auto change = fadeStep * (float)numSamples;
+        wetLevel = targetLevel > wetLevel ? juce::jmin(targetLevel, wetLevel + change) : juce::jmax(targetLevel, wetLevel - change);
+    }
+
+    delayWritePosition = (delayWritePosition + numSamples) % delayLength;
+}
+
+void TruePeakLimiter::detectPeaks(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), detectionBuffer.getNumChannels());
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        detectionBuffer.copyFrom(channel, 0, buffer, channel, startSample, numSamples);
+
+    juce::dsp::AudioBlock<float> block{ detectionBuffer };
+    auto oversampled = oversampler->processSamplesUp(block.getSubBlock(0, (size_t)numSamples).getSubsetChannelBlock(0, (size_t)numChannels));
+
+    const auto factor = (int)oversampler->getOversamplingFactor();
+    juce::FloatVectorOperations::fill(peaks, 0.0f, numSamples);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto* data = oversampled.getChannelPointer((size_t)channel);
+
+        // Each original sample owns 4 oversampled ones, the loudest of those is its true peak.
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            auto range = juce::FloatVectorOperations::findMinAndMax(data + sample * factor, factor);
+            peaks[sample] = juce::jmax(peaks[sample], -range.getStart(), range.getEnd());
+        }
+    }
+}
+
+void TruePeakLimiter::computeGain(int numSamples)
+{
+    for (int sample = 0; sample < numSamples; ++sample, ++sampleCounter)
+    {
+        const auto peak = peaks[sample];
+
+        // Anything at the back of the deque that is quieter than the new peak can never be the maximum again.
+        while (dequeSize > 0)
+        {
+            const auto back = (dequeFront + dequeSize - 1) % dequeCapacity;
+
+            if (dequeValues[back] > peak)
+                break;
+
+            --dequeSize;
+        }
+
+        const auto newBack = (dequeFront + dequeSize) % dequeCapacity;
+        dequeIndices[newBack] = sampleCounter;
+        dequeValues[newBack] = peak;
+        ++dequeSize;
+
+        // The front drops out once it is older than the window.
+        if (dequeIndices[dequeFront] <= sampleCounter - windowLength)
+        {
+            dequeFront = (dequeFront + 1) % dequeCapacity;
+            --dequeSize;
+        }
+
+        const auto windowPeak = dequeValues[dequeFront];
+        const auto targetGain = windowPeak > ceiling ? ceiling / windowPeak : 1.0f;
+
+        // Turning down happens straight away, coming back up follows the release.
+        releasedGain = targetGain < releasedGain ? targetGain : releasedGain + (targetGain - releasedGain) * releaseCoefficient;
+
+        // The moving average turns the step into a ramp that reaches the target right as the peak leaves the delay.
+        averageSum += (double)releasedGain - (double)averageHistory[averagePosition];
+        averageHistory[averagePosition] = releasedGain;
+
+        if (++averagePosition >= windowLength)
+            averagePosition = 0;
+
+        gains[sample] = (float)(averageSum / (double)windowLength);
+    }
+}
+
+float TruePeakLimiter::softClip(float sample) const
+{
+    const auto knee = ceiling * softClipKnee;
+    const auto magnitude = std::abs(sample);
+
+    if (magnitude <= knee)
+        return sample;
+
+    // Above the knee the curve x / (1 + x) bends the rest of the way up to the ceiling without ever reaching it.
+    const auto headroom = ceiling - knee;
+    const auto over = (magnitude - knee) / headroom;
+    const auto bent = knee + headroom * over / (1.0f + over);
+
+    return sample < 0.0f ? -bent : bent;
+}
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    TruePeakLimiter.h
+    Created: 18 Oct 2026 2:04:19pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// A lookahead limiter that keeps the inter-sample (true) peaks under the ceiling.
+// Peaks are found on a 4x oversampled copy of the input, then a sliding window maximum
+// and a moving average turn them into a gain that has fully ramped down by the time
+// the loud sample comes out of the delay line.
+class TruePeakLimiter
+{
+public:
+    void prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels);
+    void process(juce::AudioBuffer<float>& buffer);
+    void reset();
+    void updateParameters(const bool isEnabled, const float ceilingDecibels, const float releaseMilliseconds, const bool isSoftClipEnabled);
+
+    // How far the output is behind the input. Once the limiter is switched off and has faded out of the way
+    // the delay is skipped too, so this drops to 0 until it is switched on again.
+    int getLatencySamples() const { return bypassed ? 0 : latencySamples; }
+
+private:
+    void processChunk(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // Finds the loudest inter-sample peak across every channel for each sample of the chunk.
+    void detectPeaks(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // Turns the peaks into the gain that has to be applied to the delayed audio.
+    void computeGain(int numSamples);
+
+    // Gently bends anything above the knee so it never passes the ceiling.
+    float softClip(float sample) const;
+
+    // 4x oversampling, two stages of 2x.
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+
+    // A copy of the input that gets oversampled, so the audio itself is left alone.
+    juce::AudioBuffer<float> detectionBuffer;
+
+    // Delays the audio so the gain has time to ramp down before a peak arrives.
+    juce::AudioBuffer<float> delayBuffer;
+    int delayWritePosition{ 0 };
+
+    // One value per sample of the chunk, the peak first and the gain afterwards.
+    juce::HeapBlock<float> peaks;
+    juce::HeapBlock<float> gains;
+
+    // The monotonic deque behind the sliding window maximum, its values only ever get smaller from front to back.
+    juce::HeapBlock<juce::int64> dequeIndices;
+    juce::HeapBlock<float> dequeValues;
+    int dequeFront{ 0 };
+    int dequeSize{ 0 };
+    int dequeCapacity{ 0 };
+
+    // The moving average that turns the steps from the window into ramps.
+    juce::HeapBlock<float> averageHistory;
+    double averageSum{ 0.0 };
+    int averagePosition{ 0 };
+
+    // Counts every sample that has gone through, used as the index in the deque.
+    juce::int64 sampleCounter{ 0 };
+
+    // The gain after release smoothing, before the moving average.
+    float releasedGain{ 1.0f };
+    float releaseCoefficient{ 0.0f };
+
+    float ceiling{ 1.0f };
+    bool enabled{ true };
+    bool softClipEnabled{ false };
+
+    // How much of the limited, delayed signal is in the output, the rest is the dry input.
+    // Switching the limiter on or off moves this over fadeSeconds instead of jumping.
+    float wetLevel{ 1.0f };
+    float fadeStep{ 1.0f };
+
+    // Set once the limiter is off and fully faded out, the audio then goes straight through.
+    std::atomic<bool> bypassed{ false };
+
+    double hostSampleRate{ 44100.0 };
+    int maximumBlockSize{ 0 };
+    int windowLength{ 1 };
+    int latencySamples{ 0 };
+
+    // Roughly 1.5ms of lookahead.
+    static constexpr double lookaheadSeconds{ 0.0015 };
+
+    // How long switching between the limited and the dry signal takes.
+    static constexpr double fadeSeconds{ 0.01 };
+
+    // Where the soft clipper starts bending, as a fraction of the ceiling.
+    static constexpr float softClipKnee{ 0.8f };
+};
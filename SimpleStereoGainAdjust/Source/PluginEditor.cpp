@@ -11,7 +11,7 @@
 
 //==============================================================================
 SimpleStereoGainAdjustAudioProcessorEditor::SimpleStereoGainAdjustAudioProcessorEditor (SimpleStereoGainAdjustAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p), scope (p.getScopeSource())
 {
     gainLeftAttach = std::make_unique<Attach>(audioProcessor.getAPVTS(), "LEFTGAIN", gainLeftSlider);
     gainRightAttach = std::make_unique<Attach>(audioProcessor.getAPVTS(), "RIGHTGAIN", gainRightSlider);
@@ -21,9 +21,11 @@ SimpleStereoGainAdjustAudioProcessorEditor::SimpleStereoGainAdjustAudioProcessor
     setupSlider(gainRightSlider);
     setupSlider(gainMainSlider);
 
+    addAndMakeVisible(scope);
+
     startTimerHz(60);
 
-    setSize (400, 300);
+    setSize (600, 330);
 }
 
 SimpleStereoGainAdjustAudioProcessorEditor::~SimpleStereoGainAdjustAudioProcessorEditor()
@@ -39,16 +41,39 @@ void SimpleStereoGainAdjustAudioProcessorEditor::paint (juce::Graphics& g)
     auto& volumeLeft = audioProcessor.getLeftChannelVolume();
     auto& volumeRight = audioProcessor.getRightChannelVolume();
 
-    g.fillRect(gainLeftSlider.getRight(), (int)(300.f * (1.0f - volumeLeft.load())), (int)(getWidth() * 0.15f), getHeight());
-    g.fillRect(gainMainSlider.getRight(), (int)(300.f * (1.0f - volumeRight.load())), (int)(getWidth() * 0.15f), getHeight());
+    // The level bars fill the gaps between the sliders, the scope takes the right hand side.
+    const auto barWidth = gainMainSlider.getX() - gainLeftSlider.getRight();
+
+    g.fillRect(gainLeftSlider.getRight(), (int)(300.f * (1.0f - volumeLeft.load())), barWidth, getHeight());
+    g.fillRect(gainMainSlider.getRight(), (int)(300.f * (1.0f - volumeRight.load())), barWidth, getHeight());
+
+    // Momentary, short term and integrated loudness plus the loudness range along the bottom, and how far the compressor and ducker have turned it down.
+    auto& loudness = audioProcessor.getLoudnessMeter();
+    auto toText = [](float lufs) { return std::isfinite(lufs) ? juce::String(lufs, 1) : juce::String("-inf"); };
+
+    g.setColour(juce::Colours::black);
+    g.fillRect(loudnessArea);
+    g.setColour(juce::Colours::blanchedalmond);
+    g.setFont(13.0f);
+    g.drawFittedText("M " + toText(loudness.getMomentaryLoudness())
+                     + "   S " + toText(loudness.getShortTermLoudness())
+                     + "   I " + toText(loudness.getIntegratedLoudness()) + " LUFS"
+                     + "   LRA " + juce::String(loudness.getLoudnessRange(), 1) + " LU"
+                     + "   Comp " + juce::String(audioProcessor.getCompressor().getGainReductionDecibels(), 1) + " dB"
+                     + "   Duck " + juce::String(audioProcessor.getDucker().getGainReductionDecibels(), 1) + " dB",
+                     loudnessArea, juce::Justification::centred, 1);
 
 }
 
 void SimpleStereoGainAdjustAudioProcessorEditor::resized()
 {
-    gainLeftSlider.setBoundsRelative(0.0f, 0.0f, 0.2f, 1.0f);
-    gainRightSlider.setBoundsRelative(0.8f, 0.0f, 0.2f, 1.0f);
-    gainMainSlider.setBoundsRelative(0.35f, 0.0f, 0.3f, 1.0f);
+    auto bounds = getLocalBounds();
+    loudnessArea = bounds.removeFromBottom(30);
+    scope.setBounds(bounds.removeFromRight(200).reduced(5));
+
+    gainLeftSlider.setBounds(bounds.getProportion(juce::Rectangle<float>(0.0f, 0.0f, 0.2f, 1.0f)));
+    gainRightSlider.setBounds(bounds.getProportion(juce::Rectangle<float>(0.8f, 0.0f, 0.2f, 1.0f)));
+    gainMainSlider.setBounds(bounds.getProportion(juce::Rectangle<float>(0.35f, 0.0f, 0.3f, 1.0f)));
 }
 
 void SimpleStereoGainAdjustAudioProcessorEditor::setupSlider(juce::Slider& slider)
@@ -61,6 +86,12 @@ void SimpleStereoGainAdjustAudioProcessorEditor::setupSlider(juce::Slider& slide
     addAndMakeVisible(slider);
 }
 
+void SimpleStereoGainAdjustAudioProcessorEditor::mouseDown(const juce::MouseEvent& event)
+{
+    if (loudnessArea.contains(event.getPosition()))
+        audioProcessor.getLoudnessMeter().requestReset();
+}
+
 void SimpleStereoGainAdjustAudioProcessorEditor::timerCallback()
 {
     repaint();
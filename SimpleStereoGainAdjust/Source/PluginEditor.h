@@ -10,6 +10,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "../../Shared/StereoScope.h"
 
 //==============================================================================
 /**
@@ -27,6 +28,9 @@ public:
 
     void setupSlider(juce::Slider& slider);
 
+    // Clicking the loudness readings starts the integrated loudness and range again.
+    void mouseDown(const juce::MouseEvent& event) override;
+
     // This comes from the Timer abstract class and has to be overriden with our own code for when the timer is called.
     void timerCallback() override;
 
@@ -45,6 +49,12 @@ private:
     // access the processor object that created it.
     SimpleStereoGainAdjustAudioProcessor& audioProcessor;
 
+    // The strip along the bottom that shows the loudness readings.
+    juce::Rectangle<int> loudnessArea;
+
+    // The goniometer and correlation meter down the right hand side.
+    StereoScope scope;
+
 
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleStereoGainAdjustAudioProcessorEditor)
@@ -17,11 +17,14 @@ SimpleStereoGainAdjustAudioProcessor::SimpleStereoGainAdjustAudioProcessor()
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                       #endif
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
                        ), apvts(*this, nullptr, "PARAMETERS", createParams())
 #endif
 {
+    // Controller 20 onwards drive the parameters in the order they were added, skipping any the MIDI spec defines.
+    scheduler.mapControllers(getParameters(), firstMappedController, &apvts);
 }
 
 SimpleStereoGainAdjustAudioProcessor::~SimpleStereoGainAdjustAudioProcessor()
@@ -63,44 +66,62 @@ bool SimpleStereoGainAdjustAudioProcessor::isMidiEffect() const
 
 double SimpleStereoGainAdjustAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return silence.getTailLengthSeconds();
 }
 
 int SimpleStereoGainAdjustAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if you're not really implementing programs.
+    return juce::jmax(1, presets.getNumPresets());
 }
 
 int SimpleStereoGainAdjustAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presets.getCurrentPreset();
 }
 
 void SimpleStereoGainAdjustAudioProcessor::setCurrentProgram (int index)
 {
+    // Only queues the preset, the audio thread switches over to it at the next block.
+    presets.selectPreset(index);
 }
 
 const juce::String SimpleStereoGainAdjustAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presets.getPresetName(index);
 }
 
 void SimpleStereoGainAdjustAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    presets.renamePreset(index, newName);
 }
 
 //==============================================================================
 void SimpleStereoGainAdjustAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    scheduler.prepareToPlay(sampleRate, samplesPerBlock);
+
+    // The limiter looks ahead, so the host needs to know how far behind the output is. Switched off it adds
+    // nothing, so it is told whether it is on first.
+    updateLimiter();
+    limiter.prepareToPlay(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    reportedLatency = limiter.getLatencySamples();
+    setLatencySamples(reportedLatency);
+
+    ducker.prepareToPlay(sampleRate, samplesPerBlock);
+    compressor.prepareToPlay(sampleRate, samplesPerBlock, getMainBusNumOutputChannels());
+    loudnessMeter.prepareToPlay(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    scopeSource.prepareToPlay(sampleRate, samplesPerBlock);
+    presets.prepareToPlay(sampleRate);
+    silence.prepareToPlay(sampleRate, samplesPerBlock);
 }
 
 void SimpleStereoGainAdjustAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    presets.releaseResources();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -124,16 +145,29 @@ bool SimpleStereoGainAdjustAudioProcessor::isBusesLayoutSupported (const BusesLa
         return false;
    #endif
 
+    // The sidechain can be off, mono or stereo whatever the main bus is.
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto sidechain = layouts.getChannelSet(true, 1);
+
+        if (! sidechain.isDisabled() && sidechain != juce::AudioChannelSet::mono() && sidechain != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
     return true;
   #endif
 }
 #endif
 
-void SimpleStereoGainAdjustAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+void SimpleStereoGainAdjustAudioProcessor::processBlock (juce::AudioBuffer<float>& fullBuffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    // The host hands over the sidechain channels after the main ones, everything but the ducker only wants the main bus.
+    auto buffer = getBusBuffer(fullBuffer, false, 0);
+    const auto sidechain = getBusBuffer(fullBuffer, true, 1);
+    auto totalNumInputChannels  = getMainBusNumInputChannels();
+    auto totalNumOutputChannels = getMainBusNumOutputChannels();
 
     // In case we have more outputs than inputs, this code clears any output
     // channels that didn't contain input data, (because these aren't
@@ -144,6 +178,15 @@ void SimpleStereoGainAdjustAudioProcessor::processBlock (juce::AudioBuffer<float
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
+    // Switches to a newly selected preset once the output has faded out for it.
+    presets.beginBlock();
+
+    // While nothing is coming in or ringing out, the block is left as zeros and the DSP below is skipped.
+    const auto isActive = silence.beginBlock(buffer);
+
+    if (! isActive)
+        buffer.clear();
+
     // This is the place where you'd normally do the guts of your plugin's
     // audio processing...
     // Make sure to reset the state if your inner loop is processing
@@ -159,27 +202,123 @@ void SimpleStereoGainAdjustAudioProcessor::processBlock (juce::AudioBuffer<float
     auto* leftGain = apvts.getRawParameterValue("LEFTGAIN");
     auto* rightGain = apvts.getRawParameterValue("RIGHTGAIN");
 
-    // Loop through all the available output channels
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+    // Ducking only happens when it's switched on and the host is actually sending something to the sidechain.
+    const auto isDucking = apvts.getRawParameterValue("DUCK")->load() > 0.5f && sidechain.getNumChannels() > 0;
+
+    ducker.updateParameters(apvts.getRawParameterValue("DUCKTHRESHOLD")->load(),
+                            apvts.getRawParameterValue("DUCKRANGE")->load(),
+                            apvts.getRawParameterValue("DUCKATTACK")->load(),
+                            apvts.getRawParameterValue("DUCKRELEASE")->load(),
+                            (Ducker::Detector)(int)apvts.getRawParameterValue("DUCKMODE")->load());
+
+    if (! isDucking)
+        ducker.reset();
+
+    const auto isCompressing = apvts.getRawParameterValue("COMP")->load() > 0.5f;
+
+    compressor.updateParameters((Compressor::Mode)(int)apvts.getRawParameterValue("COMPMODE")->load(),
+                                apvts.getRawParameterValue("COMPTHRESHOLD")->load(),
+                                apvts.getRawParameterValue("COMPRATIO")->load(),
+                                apvts.getRawParameterValue("COMPKNEE")->load(),
+                                apvts.getRawParameterValue("COMPATTACK")->load(),
+                                apvts.getRawParameterValue("COMPRELEASE")->load(),
+                                apvts.getRawParameterValue("COMPLINK")->load(),
+                                apvts.getRawParameterValue("COMPMAKEUP")->load());
+
+    if (! isCompressing)
+        compressor.reset();
+
+    // Get the max value for each channel over the whole buffer, before any gain is applied.
+    if (totalNumInputChannels > 0)
+        maxChannelLeftVolume = SimdKernels::get().findPeak(buffer.getReadPointer(0), buffer.getNumSamples());
+    if (totalNumInputChannels > 1)
+        maxChannelRightVolume = SimdKernels::get().findPeak(buffer.getReadPointer(1), buffer.getNumSamples());
+
+    // The gains are read again for every segment, so a controller change lands on the right sample.
+    scheduler.process(buffer.getNumSamples(), midiMessages, [&](int startSample, int numSamples)
     {
-        // If it is the left channel...
-        if (channel == 0)
-        {
-            // Get the max value for that channel.
-            maxChannelLeftVolume = buffer.getMagnitude(0, 0, buffer.getNumSamples());
-            // Apply the correct gain to the left channel
-            buffer.applyGain(0, 0, buffer.getNumSamples(), leftGain->load());
-        }
-        // Same for the right channel...
-        else if (channel == 1)
+        // Asleep, so the segments only go by to keep the mapped controllers moving.
+        if (! isActive)
+            return;
+
+        if (isDucking)
+            ducker.process(sidechain, startSample, numSamples);
+
+        // The compressor listens to the segment before any of the gains go on.
+        if (isCompressing)
+            compressor.process(buffer, startSample, numSamples);
+
+        // The overall gain always went on the whole buffer once for every channel, so each channel gets it that
+        // many times. Sessions have been mixed at that level, so it stays, just folded into the one pass.
+        const auto overallGain = std::pow(mainGain->load(), (float)totalNumInputChannels);
+
+        // Loop through all the available output channels
+        for (int channel = 0; channel < totalNumInputChannels; ++channel)
         {
-            maxChannelRightVolume = buffer.getMagnitude(1, 0, buffer.getNumSamples());
-            // Apply the correct gain to the right channel.
-            buffer.applyGain(1, 0, buffer.getNumSamples(), rightGain->load());
+            // The left and right channels have their own gain on top of the overall gain.
+            auto channelGain = 1.0f;
+
+            if (channel == 0)
+                channelGain = leftGain->load();
+            else if (channel == 1)
+                channelGain = rightGain->load();
+
+            // Both gains, and the compression and ducking if there are any, go on in a single pass over the channel.
+            if (isCompressing)
+                compressor.applyTo(channel, buffer.getWritePointer(channel, startSample), numSamples, channelGain * overallGain,
+                                   isDucking ? ducker.getGains() : nullptr);
+            else if (isDucking)
+                ducker.applyTo(buffer.getWritePointer(channel, startSample), numSamples, channelGain * overallGain);
+            else
+                buffer.applyGain(channel, startSample, numSamples, channelGain * overallGain);
         }
-        // Finally apply the overall gain value
-        buffer.applyGain(0, buffer.getNumSamples(), mainGain->load());
+    });
+
+    // The safety stage goes last so nothing can push the output back over the ceiling.
+    updateLimiter();
+
+    if (isActive)
+        limiter.process(buffer);
+
+    // Switching the limiter on or off adds or removes its lookahead, which the host has to hear about.
+    if (limiter.getLatencySamples() != reportedLatency)
+    {
+        reportedLatency = limiter.getLatencySamples();
+        triggerAsyncUpdate();
     }
+
+    // The limiter's lookahead delay is the only thing that can still be holding sound.
+    silence.setTailLengthSeconds(limiter.getLatencySamples() / getSampleRate());
+
+    if (silence.endBlock(buffer))
+        limiter.reset();
+
+    // Fades out ahead of a queued preset, or back in after one was applied.
+    presets.endBlock(buffer);
+
+    // The loudness is measured last, while the output is still in the cache. It can't be summed inside the gain
+    // loop above, since the limiter delays and turns down what that loop wrote and the preset fade changes it
+    // again, so the meter would show something other than what actually leaves the plugin.
+    loudnessMeter.process(buffer);
+
+    // So is the correlation, which needs both channels. Asleep there is nothing to show and the meter settles back to 1.
+    if (isActive && buffer.getNumChannels() >= 2)
+        scopeSource.push(buffer.getReadPointer(0), buffer.getReadPointer(1), buffer.getNumSamples());
+
+    scopeSource.endBlock(buffer.getNumSamples());
+}
+
+void SimpleStereoGainAdjustAudioProcessor::updateLimiter()
+{
+    limiter.updateParameters(apvts.getRawParameterValue("LIMITER")->load() > 0.5f,
+                             apvts.getRawParameterValue("CEILING")->load(),
+                             apvts.getRawParameterValue("RELEASE")->load(),
+                             apvts.getRawParameterValue("SOFTCLIP")->load() > 0.5f);
+}
+
+void SimpleStereoGainAdjustAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(limiter.getLatencySamples());
 }
 
 //==============================================================================
@@ -199,12 +338,18 @@ void SimpleStereoGainAdjustAudioProcessor::getStateInformation (juce::MemoryBloc
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
+
+    // Writes every parameter into a small binary blob which is much quicker to load than XML.
+    StateSerializer::save(*this, destData);
 }
 
 void SimpleStereoGainAdjustAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
+
+    // Reads the binary blob back, or the old XML state if that is what the session holds.
+    StateSerializer::load(*this, data, sizeInBytes);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleStereoGainAdjustAudioProcessor::createParams()
@@ -215,6 +360,31 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleStereoGainAdjustAudioP
     layout.add(std::make_unique<juce::AudioParameterFloat>("LEFTGAIN", "Left Gain", 0.0f, 1.0f, 1.0f));
     layout.add(std::make_unique<juce::AudioParameterFloat>("RIGHTGAIN", "Right Gain", 0.0f, 1.0f, 1.0f));
 
+    // The output safety stage.
+    layout.add(std::make_unique<juce::AudioParameterBool>("LIMITER", "Limiter", false));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("CEILING", "Ceiling", -12.0f, 0.0f, -1.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("RELEASE", "Release", juce::NormalisableRange<float>(10.0f, 1000.0f, 1.0f, 0.4f), 100.0f));
+    layout.add(std::make_unique<juce::AudioParameterBool>("SOFTCLIP", "Soft Clip", false));
+
+    // Ducking from the sidechain.
+    layout.add(std::make_unique<juce::AudioParameterBool>("DUCK", "Duck", false));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("DUCKTHRESHOLD", "Duck Threshold", -60.0f, 0.0f, -24.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("DUCKRANGE", "Duck Range", 0.0f, 48.0f, 12.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("DUCKATTACK", "Duck Attack", juce::NormalisableRange<float>(0.1f, 100.0f, 0.1f, 0.4f), 5.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("DUCKRELEASE", "Duck Release", juce::NormalisableRange<float>(10.0f, 2000.0f, 1.0f, 0.4f), 200.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("DUCKMODE", "Duck Detector", juce::StringArray{ "Peak", "RMS" }, 0));
+
+    // The compressor, or downward expander.
+    layout.add(std::make_unique<juce::AudioParameterBool>("COMP", "Compressor", false));
+    layout.add(std::make_unique<juce::AudioParameterChoice>("COMPMODE", "Compressor Mode", juce::StringArray{ "Compress", "Expand" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("COMPTHRESHOLD", "Compressor Threshold", -60.0f, 0.0f, -18.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("COMPRATIO", "Compressor Ratio", juce::NormalisableRange<float>(1.0f, 20.0f, 0.1f, 0.4f), 4.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("COMPKNEE", "Compressor Knee", 0.0f, 24.0f, 6.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("COMPATTACK", "Compressor Attack", juce::NormalisableRange<float>(0.1f, 200.0f, 0.1f, 0.4f), 10.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("COMPRELEASE", "Compressor Release", juce::NormalisableRange<float>(5.0f, 2000.0f, 1.0f, 0.4f), 150.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("COMPLINK", "Stereo Link", 0.0f, 1.0f, 1.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>("COMPMAKEUP", "Makeup Gain", 0.0f, 24.0f, 0.0f));
+
     return layout;
 }
 
@@ -9,11 +9,21 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "Data/TruePeakLimiter.h"
+#include "Data/LoudnessMeter.h"
+#include "Data/Ducker.h"
+#include "Data/Compressor.h"
+#include "../../Shared/SubBlockScheduler.h"
+#include "../../Shared/StateSerializer.h"
+#include "../../Shared/PresetBank.h"
+#include "../../Shared/SilenceDetector.h"
+#include "../../Shared/StereoScope.h"
 
 //==============================================================================
 /**
 */
-class SimpleStereoGainAdjustAudioProcessor  : public juce::AudioProcessor
+class SimpleStereoGainAdjustAudioProcessor  : public juce::AudioProcessor,
+                                              private juce::AsyncUpdater
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -56,18 +66,63 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    std::atomic<float>& getLeftChannelVolume()  { return maxChannelLeftVolume; };
-    std::atomic<float>& getRightChannelVolume() { return maxChannelRightVolume; };
+    std::atomic<float>& getLeftChannelVolume()  { return maxChannelLeftVolume; }
+    std::atomic<float>& getRightChannelVolume() { return maxChannelRightVolume; }
 
-    juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; };
+    juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
+
+    LoudnessMeter& getLoudnessMeter() { return loudnessMeter; }
+
+    const Ducker& getDucker() const { return ducker; }
+    const Compressor& getCompressor() const { return compressor; }
+
+    StereoScopeSource& getScopeSource() { return scopeSource; }
 
 private:
     juce::AudioProcessorValueTreeState apvts;
 
     juce::AudioProcessorValueTreeState::ParameterLayout createParams();
 
+    // Reads the limiter's parameters, before preparing it as well as every block.
+    void updateLimiter();
+
+    // Tells the host the limiter's latency changed, which takes its locks so it waits for the message thread.
+    void handleAsyncUpdate() override;
+
     std::atomic<float> maxChannelLeftVolume;
     std::atomic<float> maxChannelRightVolume;
+
+    // Turns the main signal down while the sidechain is loud.
+    Ducker ducker;
+
+    // Evens out the level of the main signal, or pushes the quiet parts further down.
+    Compressor compressor;
+
+    // Keeps the output under the ceiling after all the gains have been applied.
+    TruePeakLimiter limiter;
+
+    // The latency the host was last told about or is about to be, only touched by the audio thread.
+    int reportedLatency{ 0 };
+
+    // Measures the loudness of what finally leaves the plugin.
+    LoudnessMeter loudnessMeter;
+
+    // The correlation meter and goniometer points, taken from the output alongside the loudness.
+    StereoScopeSource scopeSource;
+
+    // Splits each block up at its MIDI events.
+    SubBlockScheduler scheduler;
+
+    // The first MIDI controller that is mapped to a parameter. 20 to 31 are undefined in the MIDI spec, once
+    // they run out the scheduler carries on from the next undefined one, 85.
+    static constexpr int firstMappedController{ 20 };
+
+    // Every preset as a snapshot of parameter values, switched over without locking.
+    PresetBank presets{ *this, &apvts };
+
+    // Skips the DSP while the input and anything left ringing out are both silent.
+    SilenceDetector silence;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleStereoGainAdjustAudioProcessor)
 };